@@ -18,8 +18,6 @@
 #pragma once
 
 #include <cstdint>
-#include <future>
-#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,10 +27,9 @@
 
 namespace libgtfoklahoma {
 
-class Game;
+// Content only. Whether an action failed or a store has been left is per
+// game and tracked by Actions.
 struct ActionModel {
-  explicit ActionModel(Game &game);
-
   // Actions can be more than one type at a time so use a mask
   enum ActionType { NONE = 0,
                     STAT_CHANGE = 1u << 0u,
@@ -46,8 +43,8 @@ struct ActionModel {
   std::string display_name;
 
   // If action is INVENTORY_CHANGE type
-  // Actions aren't visible if the player doesn't meet the inventory requirements
-  bool isVisible();
+  // Actions aren't visible if the player doesn't meet the inventory requirements,
+  // see Actions::isVisible()
 
   // If action is STAT_CHANGE type
   float success_chance{0};
@@ -57,19 +54,15 @@ struct ActionModel {
   StatModel stat_delta_on_success;
   StatModel stat_delta_on_failure;
 
-  // The idea here is the client gets the result before calling `chooseAction`
+  // The idea here is the client gets the result (Actions::actionFailed()) before calling `chooseAction`
   // The engine will automatically apply stat changes but its up to the client
   // to inform the player of the result and the failure/success message
   // I guess clients could use this to cheat, but this is MY game and I'll do what I want.
   bool can_fail{false};
-  [[nodiscard]] bool failed() const;
 
   // If action is STORE type
   std::vector<int32_t> item_ids;
-  void completePurchase();
   [[nodiscard]] bool itemIsInStock(int32_t itemId) const;
-  [[nodiscard]] bool purchaseItem(int32_t id_to_buy);
-  std::future<void> purchaseComplete();
 
   // Helpers for erebody
   uint32_t type{0};
@@ -79,12 +72,5 @@ struct ActionModel {
   [[nodiscard]] bool isStoreType() const { return type & ActionType::STORE; }
 
   bool operator==(const ActionModel &rhs) const;
-
-private:
-  friend class Actions;
-  bool m_successful;
-
-  Game &m_game;
-  std::promise<void> m_purchaseComplete;
 };
 } // namespace libgtfoklahoma
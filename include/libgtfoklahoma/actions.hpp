@@ -17,68 +17,55 @@
 
 #pragma once
 
-#include <map>
+#include <functional>
 #include <memory>
 #include <unordered_set>
 
 #include <libgtfoklahoma/action_model.hpp>
+#include <libgtfoklahoma/decision.hpp>
 #include <libgtfoklahoma/stats.hpp>
 
 namespace libgtfoklahoma {
 
+class ContentCatalog;
 class Game;
 class IEventObserver;
 class Items;
 class Actions : public std::enable_shared_from_this<Actions> {
 public:
-  explicit Actions(Game &game, const char *actionJson=kActionJson);
+  // Rolls the outcome of every action in the catalog up front
+  Actions(Game &game, const ContentCatalog &catalog);
 
-  [[nodiscard]] ActionModel &getAction(int32_t id);
-  void handleAction(int32_t id, const std::shared_ptr<IEventObserver> &observer);
+  [[nodiscard]] const ActionModel &getAction(int32_t id) const;
+  // `then` runs once the action has been fully handled, which for stores is
+  // after the player has left and the engine has resumed the game.
+  void handleAction(int32_t id,
+                    const std::shared_ptr<IEventObserver> &observer,
+                    std::function<void()> then={});
+
+  // Only meaningful for actions that can fail
+  [[nodiscard]] bool actionFailed(int32_t id) const;
+
+  // Actions aren't visible if the player doesn't meet their inventory requirements
+  [[nodiscard]] bool isVisible(int32_t id) const;
+
+  // Stores
+  // Only from the game's writer thread, see Command::PurchaseItem otherwise
+  [[nodiscard]] bool purchaseItem(int32_t storeId, int32_t itemId);
+  void completePurchase(int32_t storeId);
+  // Decided (always true) once the player leaves the store. Asked afresh each time they enter it.
+  Decision<bool> &purchaseComplete(int32_t storeId);
 
   // For things that are dependent on actions having occurred
   bool actionHasHappened(int32_t actionId);
   void setActionsThatHaveAlreadyHappened(std::unordered_set<int32_t> actionIds);
-
-public:
-  ActionModel kEmptyActionModel;
+  [[nodiscard]] const std::unordered_set<int32_t> &getActionsThatHaveAlreadyHappened() const;
 
 private:
   Game &m_game;
-  std::map<int32_t, ActionModel> m_actions;
+  const ContentCatalog &m_catalog;
   std::unordered_set<int32_t> m_actionsThatHaveAlreadyHappened;
-
-  inline static const char *kActionJson = R"JSON(
-  [
-    {
-      "comment": "Default skip event",
-      "display_name": "GTFO",
-      "id": 0,
-      "type": ["NONE"]
-    },
-    {
-      "comment": "Custom skip event",
-      "display_name": "Crap.",
-      "id": 1,
-      "type": ["NONE"]
-    },
-    {
-      "comment": "Initial Store",
-      "display_name": "Enter store",
-      "id": 10,
-      "items": [0],
-      "type": ["STORE"]
-    },
-    {
-      "comment": "This ironically makes your faster as it increases comfort",
-      "id": 20,
-      "display_name": "Spark a doobie",
-      "type": ["STAT_CHANGE"],
-      "stat_changes_regardless": [
-        {"max_mph": 1}
-      ]
-    }
-  ]
-  )JSON";
+  std::unordered_set<int32_t> m_successfulActionIds;
+  DecisionTable<bool> m_purchasesComplete;
 };
 }
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libgtfoklahoma {
+
+// A fixed number of bits packed into 64-bit words, sized once up front
+class Bitset {
+public:
+  Bitset() = default;
+  explicit Bitset(size_t bitCount)
+  : m_bitCount(bitCount)
+  , m_words((bitCount + 63) / 64, 0) {}
+
+  [[nodiscard]] size_t size() const { return m_bitCount; }
+
+  [[nodiscard]] bool test(size_t bit) const {
+    return bit < m_bitCount && (m_words[bit / 64] >> (bit % 64)) & 1u;
+  }
+
+  void set(size_t bit, bool value=true) {
+    if (bit >= m_bitCount) { return; }
+    const uint64_t mask = uint64_t(1) << (bit % 64);
+    m_words[bit / 64] = value ? m_words[bit / 64] | mask : m_words[bit / 64] & ~mask;
+  }
+
+  void reset() { std::fill(m_words.begin(), m_words.end(), 0); }
+
+  // True if every bit set in `mask` is also set here. Bits past the end of
+  // this set count as unset.
+  [[nodiscard]] bool containsAll(const Bitset &mask) const {
+    for (size_t i = 0; i < mask.m_words.size(); ++i) {
+      const uint64_t word = i < m_words.size() ? m_words[i] : 0;
+      if (mask.m_words[i] & ~word) { return false; }
+    }
+    return true;
+  }
+
+  [[nodiscard]] size_t count() const {
+    size_t result = 0;
+    for (auto word : m_words) { result += __builtin_popcountll(word); }
+    return result;
+  }
+
+  // The index of the nth (from 0) set bit, or size() if there aren't that many
+  [[nodiscard]] size_t findNth(size_t n) const {
+    for (size_t i = 0; i < m_words.size(); ++i) {
+      auto word = m_words[i];
+      const auto bitsInWord = static_cast<size_t>(__builtin_popcountll(word));
+      if (n >= bitsInWord) {
+        n -= bitsInWord;
+        continue;
+      }
+      for (; n; --n) { word &= word - 1; }
+      return i * 64 + static_cast<size_t>(__builtin_ctzll(word));
+    }
+    return m_bitCount;
+  }
+
+private:
+  size_t m_bitCount{0};
+  std::vector<uint64_t> m_words;
+};
+} // namespace libgtfoklahoma
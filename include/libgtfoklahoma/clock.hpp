@@ -0,0 +1,105 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace libgtfoklahoma {
+
+/**
+ * Where the engine gets the time from and how it sleeps until a deadline.
+ * Players get the steady clock. Tests and simulations can use a virtual one
+ * so that pacing is still honoured without actually waiting around.
+ */
+class IClock {
+public:
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  virtual ~IClock() = default;
+
+  [[nodiscard]] virtual TimePoint now() const = 0;
+
+  /**
+   * Blocks on `wakeup` until `deadline` comes around on this clock or until
+   * `stop` returns true, whichever is first. Like std::condition_variable,
+   * `lock` is released while waiting and `stop` is only checked under it.
+   * @return The last result of `stop`
+   */
+  virtual bool waitUntil(std::unique_lock<std::mutex> &lock,
+                         std::condition_variable &wakeup,
+                         TimePoint deadline,
+                         const std::function<bool()> &stop) = 0;
+};
+
+class SteadyClock : public IClock {
+public:
+  [[nodiscard]] TimePoint now() const override;
+  bool waitUntil(std::unique_lock<std::mutex> &lock,
+                 std::condition_variable &wakeup,
+                 TimePoint deadline,
+                 const std::function<bool()> &stop) override;
+};
+
+/**
+ * Only moves when told to. With Mode::ADVANCE_WHEN_WAITING anyone waiting on
+ * a deadline moves the clock straight there, so an engine runs as fast as it
+ * can while still seeing the same timeline it would in real-time.
+ */
+class VirtualClock : public IClock {
+public:
+  enum class Mode { MANUAL, ADVANCE_WHEN_WAITING };
+
+  explicit VirtualClock(Mode mode=Mode::MANUAL, TimePoint start=TimePoint());
+
+  [[nodiscard]] TimePoint now() const override;
+  bool waitUntil(std::unique_lock<std::mutex> &lock,
+                 std::condition_variable &wakeup,
+                 TimePoint deadline,
+                 const std::function<bool()> &stop) override;
+
+  // Wakes up anyone whose deadline has come. Never call these while holding
+  // a lock someone waits on this clock with.
+  void advance(std::chrono::nanoseconds duration);
+  void advanceTo(TimePoint time);
+
+  // How many threads are blocked in waitUntil(), handy to tell when an engine
+  // has caught up with the clock
+  [[nodiscard]] size_t waiterCount() const;
+
+private:
+  struct Waiter {
+    std::mutex *mutex;
+    std::condition_variable *wakeup;
+  };
+
+  void addWaiter(std::unique_lock<std::mutex> &lock, std::condition_variable &wakeup);
+  void removeWaiter(std::unique_lock<std::mutex> &lock, std::condition_variable &wakeup);
+
+  Mode m_mode;
+  std::atomic<TimePoint::rep> m_now;
+
+  // Always taken before a waiter's own mutex, never while holding one
+  mutable std::mutex m_waitersMutex;
+  std::vector<Waiter> m_waiters;
+};
+} // namespace libgtfoklahoma
@@ -0,0 +1,54 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace libgtfoklahoma {
+
+// Something the player wants the engine to do, queued with Engine::submit()
+struct Command {
+  enum class Type : uint8_t {
+    CHOOSE_EVENT_ACTION,
+    CHOOSE_ISSUE_ACTION,
+    PURCHASE_ITEM,
+    LEAVE_STORE,
+    PAUSE,
+    RESUME,
+    QUIT
+  };
+
+  Type type{Type::PAUSE};
+  int32_t target_id{-1}; // The event, issue or store the command is about
+  int32_t choice_id{-1}; // The action or item chosen
+
+  static Command ChooseEventAction(int32_t eventId, int32_t actionId) {
+    return {Type::CHOOSE_EVENT_ACTION, eventId, actionId};
+  }
+  static Command ChooseIssueAction(int32_t issueId, int32_t actionId) {
+    return {Type::CHOOSE_ISSUE_ACTION, issueId, actionId};
+  }
+  static Command PurchaseItem(int32_t storeId, int32_t itemId) {
+    return {Type::PURCHASE_ITEM, storeId, itemId};
+  }
+  static Command LeaveStore(int32_t storeId) { return {Type::LEAVE_STORE, storeId}; }
+  static Command Pause() { return {Type::PAUSE}; }
+  static Command Resume() { return {Type::RESUME}; }
+  static Command Quit() { return {Type::QUIT}; }
+};
+} // namespace libgtfoklahoma
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <libgtfoklahoma/action_model.hpp>
+#include <libgtfoklahoma/bitset.hpp>
+#include <libgtfoklahoma/content_pack.hpp>
+#include <libgtfoklahoma/dense_table.hpp>
+#include <libgtfoklahoma/ending_model.hpp>
+#include <libgtfoklahoma/event_model.hpp>
+#include <libgtfoklahoma/issue_model.hpp>
+#include <libgtfoklahoma/item_model.hpp>
+
+namespace libgtfoklahoma {
+
+/**
+ * Every model in a content pack, built once and frozen. Catalogs hold no
+ * per-game state so any number of Games can share one; what a player has
+ * done with the content lives in each Game's managers instead.
+ */
+class ContentCatalog {
+public:
+  explicit ContentCatalog(const ContentPack &pack);
+
+  static std::shared_ptr<const ContentCatalog> FromPack(const ContentPack &pack);
+
+  // Built from ContentPack::BuiltIn() the first time it's asked for
+  static std::shared_ptr<const ContentCatalog> BuiltIn();
+
+  // Unknown ids are logged and get an empty model
+  [[nodiscard]] const ActionModel &getAction(int32_t id) const;
+  [[nodiscard]] const EndingModel &getEnding(int32_t id) const;
+  [[nodiscard]] const EventModel &getEvent(int32_t id) const;
+  [[nodiscard]] const IssueModel &getIssue(int32_t id) const;
+  [[nodiscard]] const ItemModel &getItem(int32_t id) const;
+
+  // Ordered by id
+  [[nodiscard]] const DenseTable<ActionModel> &getActions() const;
+  [[nodiscard]] const std::map<int32_t, std::vector<int32_t>> &getEventIdsByMile() const;
+  [[nodiscard]] const std::vector<int32_t> &getIssueIds(IssueModel::Type type) const;
+
+  // An issue's dependencies compiled down to bits over the index of each
+  // action and item in getActions() / the item table, so checking them is a
+  // few word-wide ANDs rather than a lookup per dependency.
+  struct IssueDependencies {
+    Bitset actions;
+    Bitset items;
+    // False if it depends on an action or item that isn't in the catalog
+    bool satisfiable{true};
+  };
+  [[nodiscard]] const IssueDependencies &getIssueDependencies(int32_t issueId) const;
+  [[nodiscard]] int32_t getActionIndex(int32_t actionId) const;
+  [[nodiscard]] int32_t getItemIndex(int32_t itemId) const;
+  [[nodiscard]] size_t getItemCount() const;
+
+  // The issues that depend on an action or item, so whoever's tracking which
+  // issues can happen only has to look at these when it happens or is bought
+  [[nodiscard]] const std::vector<int32_t> &getIssueIdsDependingOnAction(int32_t actionId) const;
+  [[nodiscard]] const std::vector<int32_t> &getIssueIdsDependingOnItem(int32_t itemId) const;
+
+  // Same as the pack's, see HashContent()
+  [[nodiscard]] uint64_t getContentHash() const;
+
+public:
+  inline static const ActionModel kEmptyActionModel = ActionModel();
+  inline static const EndingModel kEmptyEndingModel = EndingModel();
+  inline static const EventModel kEmptyEventModel = EventModel();
+  inline static const IssueModel kEmptyIssueModel = IssueModel();
+  inline static const ItemModel kEmptyItemModel = ItemModel();
+
+private:
+  void compileIssueDependencies();
+
+private:
+  // Looked up on every tick, see DenseTable
+  DenseTable<ActionModel> m_actions;
+  DenseTable<EndingModel> m_endings;
+  DenseTable<EventModel> m_eventsById;
+  std::map<int32_t, std::vector<int32_t>> m_eventIdsByMile;
+  DenseTable<IssueModel> m_issuesById;
+  std::unordered_map<IssueModel::Type, std::vector<int32_t>> m_issueIdsByType;
+  DenseTable<ItemModel> m_items;
+  uint64_t m_contentHash;
+
+  // Indexed like the tables they refer to
+  std::vector<IssueDependencies> m_issueDependencies;
+  std::vector<std::vector<int32_t>> m_issueIdsByActionIndex;
+  std::vector<std::vector<int32_t>> m_issueIdsByItemIndex;
+};
+} // namespace libgtfoklahoma
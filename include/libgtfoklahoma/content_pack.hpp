@@ -0,0 +1,72 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <rapidjson/document.h>
+
+namespace libgtfoklahoma {
+
+/**
+ * A full set of parsed game content. Packs are immutable once loaded and are
+ * meant to be shared by every Game using them, so content is read and parsed
+ * once rather than once per game.
+ */
+class ContentPack {
+public:
+  ~ContentPack();
+
+  /**
+   * Memory-maps actions.json, endings.json, events.json, issues.json and
+   * items.json from `directory` and parses them in place.
+   * @return nullptr if any of them are missing or aren't valid JSON
+   */
+  static std::shared_ptr<const ContentPack> LoadDirectory(const std::string &directory);
+
+  // Copies and parses content that's already in memory
+  static std::shared_ptr<const ContentPack> FromJson(const char *actionJson,
+                                                     const char *endingJson,
+                                                     const char *eventJson,
+                                                     const char *issueJson,
+                                                     const char *itemJson);
+
+  // data/ as compiled into the library, parsed the first time it's asked for
+  static std::shared_ptr<const ContentPack> BuiltIn();
+
+  [[nodiscard]] const rapidjson::Value &getActions() const;
+  [[nodiscard]] const rapidjson::Value &getEndings() const;
+  [[nodiscard]] const rapidjson::Value &getEvents() const;
+  [[nodiscard]] const rapidjson::Value &getIssues() const;
+  [[nodiscard]] const rapidjson::Value &getItems() const;
+
+  // Hash of the raw JSON, see HashContent()
+  [[nodiscard]] uint64_t getContentHash() const;
+
+private:
+  ContentPack();
+
+  // Parsed strings point into the buffer so the two live and die together
+  struct Source;
+  enum SourceIndex { ACTIONS, ENDINGS, EVENTS, ISSUES, ITEMS, SOURCE_COUNT };
+  std::unique_ptr<Source> m_sources[SOURCE_COUNT];
+  uint64_t m_contentHash;
+};
+} // namespace libgtfoklahoma
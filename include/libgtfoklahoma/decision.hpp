@@ -0,0 +1,128 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace libgtfoklahoma {
+
+/**
+ * Something the engine can wait on without blocking. The player makes the
+ * decision from whatever thread they like and whoever is waiting is called
+ * back, so the engine can go on to do other work in the meantime.
+ */
+class IDecision {
+public:
+  virtual ~IDecision() = default;
+
+  [[nodiscard]] virtual bool isDecided() const = 0;
+
+  /**
+   * @param callback Called on the deciding thread once the decision is made.
+   * If it already has been, it's called right away on this thread.
+   */
+  virtual void onDecided(std::function<void()> callback) = 0;
+};
+
+template <typename T>
+class Decision : public IDecision {
+public:
+  // Returns false if this has already been decided
+  bool decide(T value) {
+    std::function<void()> callback;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_value) { return false; }
+      m_value = std::move(value);
+      callback = std::move(m_onDecided);
+      m_onDecided = nullptr;
+    }
+    if (callback) { callback(); }
+    return true;
+  }
+
+  // Only meaningful once isDecided()
+  [[nodiscard]] T get() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_value.value_or(T());
+  }
+
+  [[nodiscard]] bool isDecided() const override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_value.has_value();
+  }
+
+  void onDecided(std::function<void()> callback) override {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_value) {
+        m_onDecided = std::move(callback);
+        return;
+      }
+    }
+    callback();
+  }
+
+  // Undecides it so it can be asked again. Anyone still waiting is forgotten.
+  void reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_value.reset();
+    m_onDecided = nullptr;
+  }
+
+private:
+  mutable std::mutex m_mutex;
+  std::optional<T> m_value;
+  std::function<void()> m_onDecided;
+};
+
+/**
+ * A game's decisions about content, keyed by the content's id. Content is
+ * shared between games so the decisions can't live on it. Only ids that
+ * actually come up are allocated, and each time one comes up again it's
+ * asked afresh rather than reusing the last answer.
+ */
+template <typename T>
+class DecisionTable {
+public:
+  // Starts asking about `id`, dropping anything decided about it before now
+  Decision<T> &ask(int32_t id) {
+    auto &decision = get(id);
+    decision.reset();
+    return decision;
+  }
+
+  // Whatever is being (or was last) asked about `id`. Safe from any thread.
+  Decision<T> &get(int32_t id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto &decision = m_decisions[id];
+    if (!decision) { decision = std::make_unique<Decision<T>>(); }
+    return *decision;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::unordered_map<int32_t, std::unique_ptr<Decision<T>>> m_decisions;
+};
+} // namespace libgtfoklahoma
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace libgtfoklahoma {
+
+/**
+ * Read-only models stored contiguously in id order and looked up by id with
+ * a single index. Content ids are small and mostly dense, so a flat id to
+ * slot table is cheaper than hashing. Ids spread too far apart for that fall
+ * back to a hash map so a stray large id can't blow up memory.
+ */
+template <typename Model>
+class DenseTable {
+public:
+  DenseTable() = default;
+
+  explicit DenseTable(std::map<int32_t, Model> models) {
+    if (models.empty()) { return; }
+
+    m_firstId = models.begin()->first;
+    auto span = static_cast<int64_t>(models.rbegin()->first) - m_firstId + 1;
+    bool dense = span <= kMaxSlotsPerModel * static_cast<int64_t>(models.size()) + kMinSlots;
+    if (dense) { m_slots.assign(static_cast<size_t>(span), kNoSlot); }
+
+    m_models.reserve(models.size());
+    for (auto &[id, model] : models) {
+      auto slot = static_cast<int32_t>(m_models.size());
+      if (dense) {
+        m_slots[static_cast<size_t>(id - m_firstId)] = slot;
+      } else {
+        m_sparseSlots.emplace(id, slot);
+      }
+      m_models.push_back(std::move(model));
+    }
+  }
+
+  // nullptr if there's no model with `id`
+  [[nodiscard]] const Model *find(int32_t id) const {
+    if (!m_sparseSlots.empty()) {
+      auto it = m_sparseSlots.find(id);
+      return it == m_sparseSlots.end() ? nullptr : &m_models[it->second];
+    }
+
+    // Ids below the first wrap around to huge offsets, so one compare covers both ends
+    auto offset = static_cast<uint64_t>(static_cast<int64_t>(id) - m_firstId);
+    if (offset >= m_slots.size()) { return nullptr; }
+    auto slot = m_slots[offset];
+    return slot == kNoSlot ? nullptr : &m_models[slot];
+  }
+
+  // Where `id` sits in id order, from 0 to size() - 1, or -1 if there's no such model
+  [[nodiscard]] int32_t indexOf(int32_t id) const {
+    auto model = find(id);
+    return model ? static_cast<int32_t>(model - m_models.data()) : kNoSlot;
+  }
+
+  [[nodiscard]] size_t size() const { return m_models.size(); }
+  [[nodiscard]] bool empty() const { return m_models.empty(); }
+
+  // In id order
+  [[nodiscard]] typename std::vector<Model>::const_iterator begin() const { return m_models.begin(); }
+  [[nodiscard]] typename std::vector<Model>::const_iterator end() const { return m_models.end(); }
+
+private:
+  static constexpr int32_t kNoSlot = -1;
+  static constexpr int64_t kMaxSlotsPerModel = 4;
+  static constexpr int64_t kMinSlots = 64;
+
+  std::vector<Model> m_models;
+  int32_t m_firstId{0};
+  std::vector<int32_t> m_slots;
+  std::unordered_map<int32_t, int32_t> m_sparseSlots;
+};
+} // namespace libgtfoklahoma
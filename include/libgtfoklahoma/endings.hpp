@@ -18,32 +18,20 @@
 #pragma once
 
 #include <cstdint>
-#include <unordered_map>
 
 #include <libgtfoklahoma/ending_model.hpp>
 
 namespace libgtfoklahoma {
 
+class ContentCatalog;
 class Endings {
 public:
-  explicit Endings(const char *endingsJson = kEndingsJson);
-  EndingModel &getEnding(int32_t id);
+  explicit Endings(const ContentCatalog &catalog);
+  [[nodiscard]] const EndingModel &getEnding(int32_t id) const;
 
   void handleEnding(int32_t id);
 
-  inline static EndingModel kEmptyEndingModel;
 private:
-  std::unordered_map<int32_t, EndingModel> m_endings;
-
-  inline static const char *kEndingsJson = R"(
-  [
-    {
-      "id": 0,
-      "description": "Your poor health choices caught up to you. Sometimes you eat the bar, and sometimes the bar eats you.",
-      "display_name": "Rest In Power.",
-      "image_tag": "health_death"
-    }
-  ]
-  )";
+  const ContentCatalog &m_catalog;
 };
 } // namespace libgtfoklahoma
\ No newline at end of file
@@ -18,31 +18,161 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
+#include <libgtfoklahoma/clock.hpp>
+#include <libgtfoklahoma/command.hpp>
+#include <libgtfoklahoma/issue_model.hpp>
+#include <libgtfoklahoma/mpsc_ring.hpp>
+#include <libgtfoklahoma/pacing.hpp>
 
 namespace libgtfoklahoma {
 
 class Game;
 class Engine {
 public:
-  explicit Engine(Game &game);
+  enum class Status { RUNNING, AWAITING_INPUT, PAUSED, GAME_OVER };
+
+  // What to run until, see runUntil()
+  enum class Until {
+    NEXT_MILE,
+    NEXT_HOUR,
+    // Only stop once the engine can't carry on by itself
+    BLOCKED
+  };
+
+  // What happened over a run of advance() calls
+  struct StepResult {
+    enum class Reason { TICKS_ELAPSED, CONDITION_MET, AWAITING_INPUT, PAUSED, GAME_OVER };
+
+    Reason reason;
+    Status status;
+    // Game time covered, counted the same way the engine's own loop paces itself
+    uint32_t ticks;
+    uint32_t miles;
+    uint32_t hours;
+  };
+
+  static constexpr uint32_t kNoTickLimit = UINT32_MAX;
+
+  explicit Engine(Game &game,
+                  std::shared_ptr<IPacingPolicy> pacing=std::make_shared<RealTimePacing>(),
+                  std::shared_ptr<IClock> clock=std::make_shared<SteadyClock>());
   ~Engine();
 
+  // Runs the engine on its own thread
   void start();
   void stop();
 
+  /**
+   * Drives the engine from the caller's thread instead of start()/stop().
+   * Processes the next tick where something can happen, or if the engine was
+   * waiting on the player, picks up where it left off once they've decided.
+   * Callers are expected to wait ticksUntilNextAdvance() ticks between calls.
+   * @return AWAITING_INPUT if the player still has to make a decision, in
+   * which case call again once they have. PAUSED until a RESUME command
+   * comes in.
+   */
+  Status advance();
+
+  /**
+   * Calls advance() on the caller's thread until `ticks` ticks have gone by,
+   * so the engine can be driven from someone else's loop without a thread of
+   * its own. Ticks where nothing can happen are skipped over rather than
+   * stepped through. Stops early if the player has to decide something, the
+   * game is paused or it's over.
+   */
+  StepResult advanceTicks(uint32_t ticks);
+
+  // Like advanceTicks() but stops as soon as `until` happens, or `done`
+  // returns true after a call to advance()
+  StepResult runUntil(Until until, uint32_t maxTicks=kNoTickLimit);
+  StepResult runUntil(const std::function<bool()> &done, uint32_t maxTicks=kNoTickLimit);
+
+  /**
+   * Queues a command for the engine to carry out on its own thread. Safe to
+   * call from any thread and never blocks. Commands are drained at the start
+   * of every advance(), and whoever drives the engine is woken up if it was
+   * waiting on the player.
+   * @return false if the queue is full, in which case try again later
+   */
+  bool submit(const Command &command);
+  // Only from the thread driving the engine
+  [[nodiscard]] bool hasPendingCommands() const;
+
+  [[nodiscard]] Status getStatus() const;
+  [[nodiscard]] uint32_t getCurrentTick() const;
+  [[nodiscard]] uint32_t ticksUntilNextAdvance() const;
+  [[nodiscard]] const IPacingPolicy &getPacingPolicy() const;
+  [[nodiscard]] const IClock &getClock() const;
+
 private:
   void handleGameOver(int32_t endingId);
+  void drainCommands();
+  void runCommand(const Command &command);
   int32_t getNextHour() const;
+  uint32_t ticksUntilNextMile() const;
   void mainLoop();
 
+  // Queues up everything that needs to happen on the current tick
+  void scheduleTick();
+  void handleEvents();
+  void handleIssues(IssueModel::Type type);
+  void updateTime();
+  void updateDistance();
+  void checkForGameOver();
+
+  // Blocks until `deadline` on the engine's clock or until the engine is
+  // stopped. Returns false if stopped.
+  bool waitUntil(IClock::TimePoint deadline);
+
+  // Blocks until the player has made the decision the game is waiting on, a
+  // command comes in or the engine is stopped. While paused only a command
+  // wakes it up. Returns false if stopped.
+  bool waitForInput();
+
 private:
   Game &m_game;
+  std::shared_ptr<IPacingPolicy> m_pacing;
+  std::shared_ptr<IClock> m_clock;
 
   std::thread m_eventLoopThread;
   std::atomic<bool> m_running;
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wakeup;
+
+  // Events are checked once per mile
+  bool m_shouldCheckForEvents;
+
+  // Issues are checked once per hour
+  bool m_shouldCheckForHealthIssues;
+  bool m_shouldCheckForMechanicalIssues;
+
+  // Nothing can happen between mile and hour boundaries, so rather than waking
+  // up every tick, jump straight to the next tick where something can happen.
+  bool m_started;
+  uint32_t m_tick;
+  uint32_t m_nextTick;
+  uint32_t m_nextMileTick;
+  Status m_status;
+  bool m_paused;
+
+  // Only ever go up, for StepResult
+  uint32_t m_milesTravelled;
+  uint32_t m_hoursPassed;
+
+  // Commands from the player's threads, drained on the engine's
+  MpscRing<Command> m_commands;
+
+  // Work left on the current tick. Anything here may suspend on player input.
+  std::deque<std::function<void()>> m_pendingWork;
 };
 }
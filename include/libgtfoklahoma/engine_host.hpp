@@ -0,0 +1,107 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <libgtfoklahoma/clock.hpp>
+#include <libgtfoklahoma/command.hpp>
+#include <libgtfoklahoma/pacing.hpp>
+#include <libgtfoklahoma/timer_wheel.hpp>
+
+namespace libgtfoklahoma {
+
+class Game;
+
+/**
+ * Runs many games on a fixed number of threads rather than a thread per Engine.
+ *
+ * Each session's Engine is driven with Engine::advance() on whichever worker
+ * is free. Between ticks a session sits in a timer wheel until its next tick
+ * is due, and while the player is making a decision it isn't queued anywhere
+ * at all until the decision wakes it back up, so neither costs a thread.
+ */
+class EngineHost {
+public:
+  using SessionId = uint64_t;
+
+  explicit EngineHost(uint32_t workerCount=std::thread::hardware_concurrency(),
+                      std::shared_ptr<IPacingPolicy> pacing=std::make_shared<RealTimePacing>(),
+                      std::shared_ptr<IClock> clock=std::make_shared<SteadyClock>());
+  ~EngineHost();
+
+  /**
+   * Starts running `game`. The game must outlive its session, which ends when
+   * the game is over or when the session is removed.
+   */
+  SessionId addSession(Game &game);
+
+  // Once this returns the host will not touch the session's game again
+  void removeSession(SessionId id);
+
+  // Passes `command` on to the session's engine. False if the session is gone
+  // or its command queue is full.
+  bool submit(SessionId id, const Command &command);
+
+  [[nodiscard]] bool hasSession(SessionId id) const;
+  [[nodiscard]] size_t sessionCount() const;
+  void stop();
+
+private:
+  struct Session;
+  using SessionPtr = std::shared_ptr<Session>;
+
+  void runSession(const SessionPtr &session);
+  void scheduleNextTick(const SessionPtr &session);
+  void finishSession(const SessionPtr &session);
+  void enqueue(SessionPtr session);
+  void resumeSession(const SessionPtr &session);
+  void timerLoop();
+  void workerLoop();
+
+private:
+  std::shared_ptr<IPacingPolicy> m_pacing;
+  std::shared_ptr<IClock> m_clock;
+  std::atomic<bool> m_running;
+  SessionId m_nextSessionId;
+
+  mutable std::mutex m_sessionsMutex;
+  std::unordered_map<SessionId, SessionPtr> m_sessions;
+
+  // Sessions ready to be advanced
+  std::mutex m_runQueueMutex;
+  std::condition_variable m_runQueueChanged;
+  std::deque<SessionPtr> m_runQueue;
+  std::vector<std::thread> m_workers;
+
+  // Sessions waiting for their next tick
+  std::mutex m_timerMutex;
+  std::condition_variable m_timerChanged;
+  TimerWheel<SessionPtr> m_timerWheel;
+  std::thread m_timerThread;
+};
+} // namespace libgtfoklahoma
@@ -18,7 +18,6 @@
 #pragma once
 
 #include <cstdint>
-#include <future>
 #include <string>
 #include <vector>
 
@@ -32,14 +31,8 @@ struct EventModel {
   std::string display_name;
   int32_t mile{-1};
 
-  bool chooseAction(int32_t actionId);
-  std::future<int32_t> chosenAction();
-
   bool operator==(const EventModel &rhs) const;
 
   [[nodiscard]] bool actionIdIsValid(int32_t actionId) const;
-
-private:
-  std::promise<int32_t> m_chosenAction;
 };
 } // namespace libgtfoklahoma
@@ -26,12 +26,13 @@
 namespace libgtfoklahoma {
 
 class Game;
-class ActionModel;
+struct ActionModel;
 struct EndingModel;
 struct EventModel;
 struct IssueModel;
 struct ItemModel;
 struct StatModel;
+struct TickChangeSet;
 class IEventObserver {
 public:
 
@@ -59,26 +60,38 @@ public:
 
   /**
    * @param event A reference to the model describing the point of interest.
+   * Choose what to do about it with Events::chooseAction().
    * @return true if this observer is responsible for handling this action
    */
-  virtual bool onEvent(EventModel &event) = 0;
+  virtual bool onEvent(const EventModel &event) = 0;
 
   /**
-   * @param issue - A reference to the IssueModel that occurred
+   * @param issue - A reference to the IssueModel that occurred. Choose what
+   * to do about it with Issues::chooseAction().
    * @return true if this observer is responsible for handling this action
    */
-  virtual bool onIssueOccurred(IssueModel &issue) = 0;
+  virtual bool onIssueOccurred(const IssueModel &issue) = 0;
 
   /**
+   * While the engine is running a tick this is called once, when the tick is
+   * committed, no matter how many times the stats changed during it.
    * @param stats - A reference to the updated stat model
    */
   virtual void onStatsChanged(const StatModel &stats) = 0;
 
   /**
-   * @param action - A referene to the action that triggered entering the store
+   * Called once at the end of every tick the engine runs, after
+   * onStatsChanged(). Handy for redrawing everything in one go.
+   * @param changes - How the stats, inventory, mile and hour changed
+   */
+  virtual void onTickCommitted(const TickChangeSet &changes) {}
+
+  /**
+   * @param action - A referene to the action that triggered entering the store.
+   * Shop with Actions::purchaseItem() and leave with Actions::completePurchase().
    * @return true if this observer is responsible for handling this action
    */
-  virtual bool onStoreEntered(ActionModel &action) = 0;
+  virtual bool onStoreEntered(const ActionModel &action) = 0;
 
 protected:
   Game &m_game;
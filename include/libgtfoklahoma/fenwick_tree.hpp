@@ -0,0 +1,84 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace libgtfoklahoma {
+
+/**
+ * Running totals over a fixed number of weights (a Fenwick tree). Changing a
+ * weight, summing a prefix and finding where a running total lands are all
+ * O(log n), which makes it a cheap way to sample from a set that changes
+ * a little at a time.
+ */
+template <typename T>
+class FenwickTree {
+public:
+  FenwickTree() : FenwickTree(0) {}
+  explicit FenwickTree(size_t size)
+  : m_tree(size + 1, T{})
+  , m_total{}
+  , m_topStep(1) {
+    while (m_topStep * 2 <= size) { m_topStep *= 2; }
+  }
+
+  [[nodiscard]] size_t size() const { return m_tree.size() - 1; }
+  [[nodiscard]] T total() const { return m_total; }
+
+  void add(size_t index, T delta) {
+    if (index >= size()) { return; }
+    m_total += delta;
+    for (++index; index < m_tree.size(); index += lowestBit(index)) {
+      m_tree[index] += delta;
+    }
+  }
+
+  // The sum of the first `count` weights
+  [[nodiscard]] T prefixSum(size_t count) const {
+    T result{};
+    for (count = count < size() ? count : size(); count; count -= lowestBit(count)) {
+      result += m_tree[count];
+    }
+    return result;
+  }
+
+  // The index of the weight the running total passes `value` in, or size()
+  // if `value` isn't below total(). Weights must not be negative.
+  [[nodiscard]] size_t upperBound(T value) const {
+    size_t position = 0;
+    for (size_t step = m_topStep; step; step /= 2) {
+      const auto next = position + step;
+      if (next < m_tree.size() && !(value < m_tree[next])) {
+        position = next;
+        value -= m_tree[next];
+      }
+    }
+    return position;
+  }
+
+private:
+  static size_t lowestBit(size_t index) { return index & (~index + 1); }
+
+  // 1-based, m_tree[i] holds the sum of the lowestBit(i) weights ending at i
+  std::vector<T> m_tree;
+  T m_total;
+  size_t m_topStep;
+};
+} // namespace libgtfoklahoma
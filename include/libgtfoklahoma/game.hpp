@@ -20,33 +20,72 @@
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <stack>
 #include <string>
 
 #include <libgtfoklahoma/actions.hpp>
+#include <libgtfoklahoma/content_catalog.hpp>
+#include <libgtfoklahoma/decision.hpp>
 #include <libgtfoklahoma/endings.hpp>
 #include <libgtfoklahoma/event_observer.hpp>
 #include <libgtfoklahoma/events.hpp>
+#include <libgtfoklahoma/inventory.hpp>
 #include <libgtfoklahoma/issues.hpp>
 #include <libgtfoklahoma/items.hpp>
+#include <libgtfoklahoma/journal.hpp>
+#include <libgtfoklahoma/observer_registry.hpp>
+#include <libgtfoklahoma/rng.hpp>
+#include <libgtfoklahoma/seqlock.hpp>
 #include <libgtfoklahoma/stats.hpp>
+#include <libgtfoklahoma/tick_change_set.hpp>
 
 namespace libgtfoklahoma {
 
 class IEventObserver;
+
+/**
+ * Threading
+ *
+ * A game has a single writer: whichever thread is driving its Engine, either
+ * the engine's own thread or the caller of Engine::advance(). Every mutation
+ * and every observer callback happens there, and only that thread (or any
+ * thread while no engine is running) may use the accessors below.
+ *
+ * Other threads are limited to:
+ *  - getPlayerState(), a consistent, lock-free copy of the stats, mile and
+ *    hour. UIs should render from this rather than getStats() and friends.
+ *  - Submitting Commands to the engine, which carries them out on its thread.
+ *  - Making decisions through the managers' chooseAction() and
+ *    completePurchase(), which are backed by thread safe Decisions.
+ *    purchaseItem() changes the inventory and stats on the calling thread,
+ *    so purchases from other threads must go through Command::PurchaseItem.
+ *  - registerEventObserver().
+ */
 class Game {
 public:
-  explicit Game(std::string name);
+  // Games with the same seed and the same choices play out the same way
+  explicit Game(std::string name, uint64_t seed=Rng::RandomSeed());
   explicit Game(std::string name,
                 const char *actionJson,
                 const char *endingJson,
                 const char *eventJson,
                 const char *issueJson,
-                const char *itemJson);
+                const char *itemJson,
+                uint64_t seed=Rng::RandomSeed());
+  // Catalogs are shared, prefer this when running many games with the same content
+  explicit Game(std::string name,
+                std::shared_ptr<const ContentCatalog> catalog,
+                uint64_t seed=Rng::RandomSeed());
 
   // Action management
   Actions &getActions();
 
+  // Content management
+  [[nodiscard]] const std::shared_ptr<const ContentCatalog> &getCatalog() const;
+
   // Distance management
   [[nodiscard]] int32_t getCurrentMile() const;
   void setCurrentMile(int32_t mile);
@@ -60,12 +99,39 @@ public:
   [[nodiscard]] std::vector<int32_t> getQueuedEventIds() const;
   [[nodiscard]] int32_t popEndingHintId();
   void pushEndingHintId(int32_t endingId);
+  // Bottom of the stack first
+  [[nodiscard]] std::vector<int32_t> getEndingHintIds() const;
+  void setEndingHintIds(const std::vector<int32_t> &endingIds);
+
+  // Input management
+  // Handlers never block on the player. They hand over the decision they need
+  // and what to do once it's made. If the player hasn't decided yet the game is
+  // suspended until the engine resumes it.
+  void awaitInput(IDecision &decision, std::function<void()> resume);
+  [[nodiscard]] bool awaitingInput() const;
+  // Whether the game is suspended on `decision` and it's still undecided
+  [[nodiscard]] bool isAwaiting(const IDecision &decision) const;
+  [[nodiscard]] bool inputIsReady() const;
+  bool resumeIfReady();
+
+  // Called on the deciding thread whenever a decision the game is suspended on is made.
+  // Whoever drives the engine uses this to know when to resume it.
+  void setInputListener(std::function<void()> listener);
+  // Calls the listener from this thread, eg: once a command has been queued up
+  void notifyInputListener();
 
   // Inventory management
   void addItemToInventory(int32_t id, int32_t quantity=1);
   void removeItemFromInventory(int32_t id, int32_t quantity=1);
+  // Item id to quantity. Every item's stat changes are applied in one update.
+  void addItemsToInventory(const std::map<int32_t, int32_t> &quantities);
+  void removeItemsFromInventory(const std::map<int32_t, int32_t> &quantities);
   [[nodiscard]] int32_t inventoryCount(int32_t id) const;
-  [[nodiscard]] std::vector<std::reference_wrapper<ItemModel>> getInventory();
+  // Each item held along with how many of it, valid until the inventory changes
+  [[nodiscard]] InventoryView getInventory() const;
+  // Setting it doesn't apply any of the items' stat changes
+  [[nodiscard]] const Inventory &getInventoryCounts() const;
+  void setInventoryCounts(Inventory inventory);
 
   // Issue management
   Issues &getIssues();
@@ -73,32 +139,105 @@ public:
   // Item management
   Items &getItems();
 
+  // Journal management
+  // Records every input from here on, along with how the game ends. Must be
+  // called before the engine starts for the journal to be replayable.
+  void recordTo(std::shared_ptr<Journal> journal);
+  [[nodiscard]] uint64_t getContentHash() const;
+  void recordInput(JournalEntry entry);
+  void recordGameOver(int32_t endingId);
+
   // Observer management
-  std::vector<std::shared_ptr<IEventObserver>>
-  getObservers();
+  // The list stays valid for the life of the game, so it can be iterated
+  // without holding onto it
+  [[nodiscard]] const ObserverRegistry::List &getObservers() const;
   void registerEventObserver(std::shared_ptr<IEventObserver> observer);
 
+  // Random numbers
+  // Each kind of roll has its own stream so e.g. an extra issue roll doesn't
+  // change the outcome of every action after it.
+  [[nodiscard]] uint64_t getSeed() const;
+  Rng &getActionRng();
+  Rng &getIssueRng();
+
+  // Save management
+  // What's changed since the last checkpoint. Scalars like stats, mile and
+  // hour are cheap enough to always save so only collections are tracked.
+  struct Changes {
+    std::set<int32_t> inventory_ids;
+    std::vector<int32_t> happened_action_ids;
+    std::vector<int32_t> happened_issue_ids;
+  };
+  Changes &getUnsavedChanges();
+  Changes takeUnsavedChanges();
+
+  // State management
+  // What readers on other threads need to render the player. Published every
+  // time one of them changes.
+  struct PlayerState {
+    StatModel stats;
+    int32_t mile;
+    int32_t hour;
+  };
+  // Safe to call from any thread
+  [[nodiscard]] PlayerState getPlayerState() const;
+
   // Stat management
   Stats &getStats();
   [[nodiscard]] bool playerIsAwake() const;
   void updateStats(const StatModel &delta);
 
+  // Tick management
+  // The engine opens a tick before running it and commits it once the tick's
+  // work is done. Changes in between are coalesced and observers hear about
+  // them once on commit. Opening a tick that's already open does nothing.
+  void beginTick(uint32_t tick);
+  void commitTick();
+  // Commits what's changed so far and carries on with the same tick, for
+  // input the player expects to see the effect of straight away
+  void flushTick();
+
   // Time management
   [[nodiscard]] int32_t getCurrentHour() const;
   void setCurrentHour(int32_t hour);
 
 private:
+  // Stats publishes whenever the player's stats are set
+  friend class Stats;
+  void publishPlayerState();
+
+  // Adds to the open tick's inventory diff, if there is one
+  void recordInventoryChange(int32_t id, int32_t quantity);
+  // Just the bookkeeping, no stat changes
+  void storeItem(int32_t id, int32_t quantity);
+
+private:
+  // Declared first as the managers all look things up in it, and Actions
+  // rolls every outcome as it's constructed
+  std::shared_ptr<const ContentCatalog> m_catalog;
+  uint64_t m_seed;
+  Rng m_actionRng;
+  Rng m_issueRng;
+
   Actions m_actions;
   int32_t m_currentHour;
   int32_t m_currentMile;
   Endings m_endings;
   std::stack<int32_t> m_endingHints;
   Events m_events;
-  std::map<int32_t, int32_t> m_inventory;
+  Inventory m_inventory;
+  std::shared_ptr<Journal> m_journal;
+  std::optional<TickChangeSet> m_openTick;
+  IDecision *m_pendingInput;
+  std::function<void()> m_resumeOnInput;
+  std::function<void()> m_inputListener;
+  std::mutex m_inputListenerMutex;
   Items m_items;
   Issues m_issues;
   std::string m_name;
-  std::vector<std::shared_ptr<IEventObserver>> m_observers;
+  ObserverRegistry m_observers;
+  SeqLock<PlayerState> m_playerState;
+  Changes m_unsavedChanges;
   Stats m_stats;
 };
 }
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <libgtfoklahoma/item_model.hpp>
+
+namespace libgtfoklahoma {
+
+/**
+ * Item id to quantity, kept as a flat vector sorted by id. Players carry a
+ * handful of distinct items, so a binary search over a few contiguous entries
+ * beats chasing map nodes, and once it's grown to fit their kit adding and
+ * removing items doesn't allocate.
+ */
+class Inventory {
+public:
+  struct Entry {
+    int32_t id;
+    int32_t quantity;
+
+    bool operator==(const Entry &rhs) const { return id == rhs.id && quantity == rhs.quantity; }
+  };
+  using const_iterator = std::vector<Entry>::const_iterator;
+
+  // @return How many of `id` there are, 0 if none
+  [[nodiscard]] int32_t count(int32_t id) const;
+
+  // nullptr if there are none of `id`
+  [[nodiscard]] const Entry *find(int32_t id) const;
+
+  // Nothing happens unless `quantity` is positive
+  void add(int32_t id, int32_t quantity);
+
+  // @return How many were actually removed
+  int32_t remove(int32_t id, int32_t quantity);
+
+  void clear();
+
+  [[nodiscard]] size_t size() const { return m_entries.size(); }
+  [[nodiscard]] bool empty() const { return m_entries.empty(); }
+
+  // In id order
+  [[nodiscard]] const_iterator begin() const { return m_entries.begin(); }
+  [[nodiscard]] const_iterator end() const { return m_entries.end(); }
+
+  bool operator==(const Inventory &rhs) const { return m_entries == rhs.m_entries; }
+
+private:
+  std::vector<Entry>::iterator lowerBound(int32_t id);
+  [[nodiscard]] const_iterator lowerBound(int32_t id) const;
+
+  std::vector<Entry> m_entries;
+};
+
+class Items;
+
+/**
+ * Walks an inventory as (item, quantity) pairs without copying anything, so
+ * it's cheap enough to render from or check rules against every tick. Only
+ * valid until the inventory next changes.
+ */
+class InventoryView {
+public:
+  struct Entry {
+    const ItemModel &item;
+    int32_t quantity;
+  };
+
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Entry;
+
+    Iterator(Inventory::const_iterator it, const Items &items) : m_it(it), m_items(&items) {}
+
+    Entry operator*() const;
+    Iterator &operator++() {
+      ++m_it;
+      return *this;
+    }
+    bool operator==(const Iterator &rhs) const { return m_it == rhs.m_it; }
+    bool operator!=(const Iterator &rhs) const { return m_it != rhs.m_it; }
+
+  private:
+    Inventory::const_iterator m_it;
+    const Items *m_items;
+  };
+
+  InventoryView(const Inventory &inventory, const Items &items);
+
+  [[nodiscard]] Iterator begin() const { return Iterator(m_inventory.begin(), m_items); }
+  [[nodiscard]] Iterator end() const { return Iterator(m_inventory.end(), m_items); }
+
+  // Distinct items, not the total quantity
+  [[nodiscard]] size_t size() const { return m_inventory.size(); }
+  [[nodiscard]] bool empty() const { return m_inventory.empty(); }
+
+private:
+  const Inventory &m_inventory;
+  const Items &m_items;
+};
+} // namespace libgtfoklahoma
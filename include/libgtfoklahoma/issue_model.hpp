@@ -18,7 +18,6 @@
 #pragma once
 
 #include <cstdint>
-#include <future>
 #include <string>
 #include <vector>
 
@@ -43,12 +42,7 @@ struct IssueModel {
   Type type{Type::INVALID};
 
   [[nodiscard]] bool actionIdIsValid(int32_t actionId) const;
-  bool chooseAction(int32_t actionId);
-  std::future<int32_t> chosenAction();
 
   bool operator==(const IssueModel &rhs) const;
-
-private:
-  std::promise<int32_t> m_chosenAction;
 };
 } // namespace libgtfoklahoma
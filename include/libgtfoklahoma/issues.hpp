@@ -18,78 +18,79 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <libgtfoklahoma/bitset.hpp>
+#include <libgtfoklahoma/decision.hpp>
+#include <libgtfoklahoma/fenwick_tree.hpp>
 #include <libgtfoklahoma/issue_model.hpp>
 #include <libgtfoklahoma/stats.hpp>
 
 namespace libgtfoklahoma {
 
+class ContentCatalog;
 class Game;
 class IEventObserver;
 class Issues {
 public:
-  explicit Issues(Game &game, const char *issuesJson=kIssuesJson);
-  IssueModel &getIssue(int32_t id);
-  void handleIssue(int32_t id, const std::shared_ptr<IEventObserver> &observer);
+  Issues(Game &game, const ContentCatalog &catalog);
+  [[nodiscard]] const IssueModel &getIssue(int32_t id) const;
+  // `then` runs once the issue has been fully handled, which may be after
+  // the player has decided and the engine has resumed the game.
+  void handleIssue(int32_t id,
+                   const std::shared_ptr<IEventObserver> &observer,
+                   std::function<void()> then={});
   int32_t popRandomIssueId(IssueModel::Type type);
 
+  // Returns false if the action isn't one of the issue's or it's already been
+  // chosen this time around. Each time the issue comes up it's asked afresh.
+  bool chooseAction(int32_t issueId, int32_t actionId);
+  Decision<int32_t> &chosenAction(int32_t issueId);
+
   [[nodiscard]] std::unordered_set<int32_t> getIssuesThatHaveAlreadyHappened() const;
   void setIssuesThatHaveAlreadyHappened(std::unordered_set<int32_t> ids);
 
-public:
-  inline static IssueModel kEmptyIssueModel;
+  // Keep track of which issues can happen as the player does things. The
+  // id-less versions recheck everything, for after a restore.
+  void actionHappened(int32_t actionId);
+  void actionsChanged();
+  void inventoryChanged(int32_t itemId);
+  void inventoryChanged();
 
 private:
+  // One entry per getIssueIds(type) entry, in the same order. An issue that
+  // can happen right now has its bit set and a weight of one, so picking a
+  // random running total picks uniformly from the eligible issues.
+  struct EligibleIssues {
+    explicit EligibleIssues(size_t size) : bits(size), weights(size) {}
+    void set(size_t position, bool eligible);
+
+    Bitset bits;
+    FenwickTree<int32_t> weights;
+  };
+
   [[nodiscard]] bool canServeIssue(int32_t issueId) const;
+  void updateEligibility(int32_t issueId);
+  void updateEligibility();
 
 private:
   Game &m_game;
+  const ContentCatalog &m_catalog;
 
-  std::unordered_map<IssueModel::Type, std::vector<int32_t>> m_issuesByType;
-  std::unordered_map<int32_t, IssueModel> m_issuesById;
   std::unordered_set<int32_t> m_issuesThatHaveAlreadyHappened;
 
-  inline static const char *kIssuesJson = R"JSON(
-  [
-    {
-      "id": 0,
-      "actions": [0, 20],
-      "description": "A dodgy fella offers to share a homemade cigarette with you.",
-      "display_name": "Roast a bone?",
-      "dependent_inventory": [1],
-      "image_url": "",
-      "type": "HEALTH"
-    },
-    {
-      "id": 10,
-      "actions": [1],
-      "description": "Probably shouldn't have shared a joint with a stranger :-/ You have a fever, trouble breathing, and a dry cough.",
-      "display_name": "You have COVID-19",
-      "dependent_actions": [20],
-      "ending_id_hints": [0],
-      "image_url": "",
-      "stat_changes": [
-        {"health": -60},
-        {"max_speed": -3}
-      ],
-      "type": "HEALTH"
-    },
-    {
-      "id": 20,
-      "actions": [1],
-      "description": "Someone stole your rear reflector.",
-      "display_name": "Stop! Thief!",
-      "image_url": "",
-      "stat_changes": [
-        {"odds_health_issue": 0.1}
-      ],
-      "type": "MECHANICAL"
-    }
-  ]
-  )JSON";
+  // Bits over the catalog's action and item indexes, see ContentCatalog::IssueDependencies
+  Bitset m_happenedActions;
+  Bitset m_ownedItems;
+
+  EligibleIssues m_eligibleHealthIssues;
+  EligibleIssues m_eligibleMechanicalIssues;
+  std::unordered_map<int32_t, size_t> m_issuePositions;
+
+  DecisionTable<int32_t> m_chosenActions;
 };
 } // namespace libgtfoklahoma
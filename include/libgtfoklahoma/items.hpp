@@ -18,49 +18,18 @@
 #pragma once
 
 #include <cstdint>
-#include <unordered_map>
-#include <string>
 
 #include <libgtfoklahoma/item_model.hpp>
 
 namespace libgtfoklahoma {
 
+class ContentCatalog;
 class Items {
 public:
-  explicit Items(const char *itemsJson=kItemsJson);
-  ItemModel &getItem(int32_t id);
-
-public:
-  inline static ItemModel kEmptyItemModel;
+  explicit Items(const ContentCatalog &catalog);
+  [[nodiscard]] const ItemModel &getItem(int32_t id) const;
 
 private:
-  std::unordered_map<int32_t, ItemModel> m_items;
-
-  inline static const char *kItemsJson = R"JSON(
-  [
-      {
-        "id": 0,
-        "category": "BIKE",
-        "cost": 1200,
-        "display_name": "Burly - Over The Road Trucker",
-        "image_url": "",
-        "stat_changes": [
-          {"kit_weight": 35},
-          {"max_mph": 12},
-          {"money_remaining": -1200},
-          {"odds_mech_issue": -0.05},
-          {"odds_health_issue": -0.02}
-        ]
-      },
-      {
-        "id": 1,
-        "category": "MISC",
-        "cost": 2,
-        "display_name": "Bick Lighter",
-        "image_url": "",
-        "stat_changes": [{}]
-      }
-  ]
-  )JSON";
+  const ContentCatalog &m_catalog;
 };
 } // namespace libgtfoklahoma
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <libgtfoklahoma/stat_model.hpp>
+
+namespace libgtfoklahoma {
+
+// One thing the player did. Replaying them in order reproduces the game.
+struct JournalEntry {
+  enum class Type : uint8_t {
+    EVENT_ACTION, // id: event, value: chosen action
+    ISSUE_ACTION, // id: issue, value: chosen action
+    PURCHASE,     // id: store action, value: item bought
+    LEAVE_STORE,  // id: store action
+    // The player let the prompt go by without handling it
+    EVENT_DECLINED, // id: event
+    ISSUE_DECLINED  // id: issue
+  };
+  Type type{Type::EVENT_ACTION};
+  int32_t id{-1};
+  int32_t value{-1};
+
+  bool operator==(const JournalEntry &rhs) const;
+};
+
+// How the game ended
+struct JournalOutcome {
+  int32_t ending_id{-1};
+  int32_t hour{0};
+  int32_t mile{0};
+  StatModel stats;
+
+  bool operator==(const JournalOutcome &rhs) const;
+};
+
+/**
+ * A compact record of a playthrough: the seed, a hash of the content it was
+ * played with and every input the player made. Inputs are only ever recorded
+ * from the engine's thread or while the game is suspended waiting on them, so
+ * a journal is never appended to from two threads at once.
+ */
+class Journal {
+public:
+  static const uint16_t kVersion = 1;
+
+  Journal() = default;
+  Journal(uint64_t seed, uint64_t contentHash);
+
+  void append(JournalEntry entry);
+  void setOutcome(JournalOutcome outcome);
+
+  [[nodiscard]] uint64_t getSeed() const;
+  [[nodiscard]] uint64_t getContentHash() const;
+  [[nodiscard]] const std::vector<JournalEntry> &getEntries() const;
+  [[nodiscard]] const std::optional<JournalOutcome> &getOutcome() const;
+
+  [[nodiscard]] std::vector<uint8_t> serialize() const;
+  static std::optional<Journal> Deserialize(const uint8_t *data, size_t size);
+
+  bool writeToFile(const std::string &path) const;
+  static std::optional<Journal> ReadFromFile(const std::string &path);
+
+private:
+  uint64_t m_seed{0};
+  uint64_t m_contentHash{0};
+  std::vector<JournalEntry> m_entries;
+  std::optional<JournalOutcome> m_outcome;
+};
+
+// FNV-1a over every piece of content, used to check a journal is replayed against what it was recorded with
+uint64_t HashContent(std::initializer_list<const char *> json);
+
+class Game;
+struct ReplayResult {
+  bool matches{false};
+  std::string mismatch; // What went wrong first, if it doesn't match
+  JournalOutcome outcome;
+};
+
+/**
+ * Replays `journal` headlessly as fast as possible and checks the game ends
+ * the way it did when it was recorded. `game` must be freshly constructed with
+ * the journal's seed and the same content.
+ */
+ReplayResult Replay(const Journal &journal, Game &game, uint32_t maxTicks=1000000);
+} // namespace libgtfoklahoma
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace libgtfoklahoma {
+
+/**
+ * A bounded, lock-free queue any number of threads can push into and a
+ * single thread pops from. Each slot carries a sequence number saying whose
+ * turn it is, so producers only contend on claiming a slot and the consumer
+ * never touches the producers' cache line. Pushing into a full ring fails
+ * rather than blocking or allocating, leaving backpressure to the caller.
+ */
+template <typename T>
+class MpscRing {
+public:
+  // Rounded up to a power of two
+  explicit MpscRing(size_t capacity)
+  : m_mask(roundUpToPowerOfTwo(capacity) - 1)
+  , m_slots(std::make_unique<Slot[]>(m_mask + 1))
+  , m_head(0)
+  , m_tail(0) {
+    for (size_t i = 0; i <= m_mask; ++i) {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRing(const MpscRing&) = delete;
+  MpscRing &operator=(const MpscRing&) = delete;
+
+  // Safe to call from any thread. Returns false if the ring is full.
+  bool tryPush(T value) {
+    size_t position = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot &slot = m_slots[position & m_mask];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+      if (lag == 0) {
+        if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          slot.value = std::move(value);
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        // The consumer hasn't freed this slot from the last time around
+        return false;
+      } else {
+        // Another producer got here first
+        position = m_head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer only. Returns false if there's nothing (fully pushed) to pop.
+  bool tryPop(T &value) {
+    Slot &slot = m_slots[m_tail & m_mask];
+    if (slot.sequence.load(std::memory_order_acquire) != m_tail + 1) { return false; }
+    value = std::move(slot.value);
+    slot.sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+    ++m_tail;
+    return true;
+  }
+
+  // Consumer only
+  [[nodiscard]] bool hasPending() const {
+    return m_slots[m_tail & m_mask].sequence.load(std::memory_order_acquire) == m_tail + 1;
+  }
+
+  [[nodiscard]] size_t capacity() const { return m_mask + 1; }
+
+private:
+  static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < std::max<size_t>(value, 1)) { result <<= 1; }
+    return result;
+  }
+
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  const size_t m_mask;
+  std::unique_ptr<Slot[]> m_slots;
+
+  // Producers and the consumer each get their own cache line
+  alignas(64) std::atomic<size_t> m_head;
+  alignas(64) size_t m_tail;
+};
+} // namespace libgtfoklahoma
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <libgtfoklahoma/event_observer.hpp>
+
+namespace libgtfoklahoma {
+
+/**
+ * The observers registered with a game. Registering copies the list and
+ * publishes the copy, so dispatch reads the current list without locking,
+ * allocating or touching any refcounts. Old lists are retired rather than
+ * freed so anyone still iterating one is safe; observers are registered a
+ * handful of times per game so they're only reclaimed along with the registry.
+ */
+class ObserverRegistry {
+public:
+  using List = std::vector<std::shared_ptr<IEventObserver>>;
+
+  ObserverRegistry();
+  ObserverRegistry(const ObserverRegistry&) = delete;
+  ObserverRegistry &operator=(const ObserverRegistry&) = delete;
+
+  // Safe to call from any thread
+  void add(std::shared_ptr<IEventObserver> observer);
+
+  // Stays valid, and unchanged, for as long as the registry is around
+  [[nodiscard]] const List &get() const;
+
+private:
+  std::atomic<const List*> m_current;
+  std::mutex m_writeMutex;
+  std::vector<std::unique_ptr<const List>> m_lists;
+};
+} // namespace libgtfoklahoma
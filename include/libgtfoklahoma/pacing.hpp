@@ -0,0 +1,62 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace libgtfoklahoma {
+
+/**
+ * Decides how much wall-clock time the engine spends on a run of ticks.
+ * Swap these out to run the engine in real-time for players, faster than
+ * real-time for demos, or as fast as the CPU allows for headless simulation.
+ */
+class IPacingPolicy {
+public:
+  virtual ~IPacingPolicy() = default;
+
+  /**
+   * @param ticks The number of engine ticks about to be advanced
+   * @return How long the engine should wait before processing them
+   */
+  [[nodiscard]] virtual std::chrono::nanoseconds delayForTicks(uint32_t ticks) const = 0;
+};
+
+// One tick every rules::kTickDelayMs. This is what players expect.
+class RealTimePacing : public IPacingPolicy {
+public:
+  [[nodiscard]] std::chrono::nanoseconds delayForTicks(uint32_t ticks) const override;
+};
+
+// Real-time multiplied by `speed`, eg: 2.0 runs twice as fast, 0.5 half as fast.
+class ScaledPacing : public IPacingPolicy {
+public:
+  explicit ScaledPacing(double speed);
+  [[nodiscard]] std::chrono::nanoseconds delayForTicks(uint32_t ticks) const override;
+
+private:
+  double m_speed;
+};
+
+// Never waits. Ticks are advanced as fast as the engine can process them.
+class UnthrottledPacing : public IPacingPolicy {
+public:
+  [[nodiscard]] std::chrono::nanoseconds delayForTicks(uint32_t ticks) const override;
+};
+} // namespace libgtfoklahoma
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace libgtfoklahoma {
+
+/**
+ * xoshiro256** - small, fast and good enough for dice rolls. Unlike the
+ * standard distributions, everything here gives the same results on every
+ * platform so a seed always plays out the same way.
+ */
+class Rng {
+public:
+  using result_type = uint64_t;
+  using State = std::array<uint64_t, 4>;
+
+  // Streams with the same seed but different ids are independent of each other
+  explicit Rng(uint64_t seed=0, uint64_t stream=0);
+
+  static uint64_t RandomSeed();
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+  result_type operator()() { return next(); }
+
+  inline uint64_t next();
+
+  // @return A double in the range [0, 1)
+  double nextDouble() { return (next() >> 11u) * 0x1.0p-53; }
+
+  // @return An integer in the range [0, bound), bound must be greater than 0
+  uint64_t nextBelow(uint64_t bound);
+
+  [[nodiscard]] const State &getState() const { return m_state; }
+  void setState(const State &state) { m_state = state; }
+
+private:
+  static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+  State m_state;
+};
+
+uint64_t Rng::next() {
+  const auto result = rotl(m_state[1] * 5, 7) * 9;
+  const auto t = m_state[1] << 17u;
+  m_state[2] ^= m_state[0];
+  m_state[3] ^= m_state[1];
+  m_state[1] ^= m_state[2];
+  m_state[0] ^= m_state[3];
+  m_state[2] ^= t;
+  m_state[3] = rotl(m_state[3], 45);
+  return result;
+}
+
+/**
+ * Many independent Rngs stepped together, one lane per rider in a batch.
+ * Each state word is kept in its own array so a draw for every lane is a
+ * single loop with no dependencies between lanes, which compilers vectorize.
+ * Lane i gives exactly what the Rng it was added from would have.
+ */
+class RngBatch {
+public:
+  void add(const Rng &rng);
+  [[nodiscard]] size_t size() const { return m_s0.size(); }
+  [[nodiscard]] Rng::State getState(size_t lane) const;
+
+  // One draw per lane, same as Rng::nextDouble(). Valid until the next call.
+  const std::vector<double> &nextDoubles();
+
+private:
+  std::vector<uint64_t> m_s0;
+  std::vector<uint64_t> m_s1;
+  std::vector<uint64_t> m_s2;
+  std::vector<uint64_t> m_s3;
+  std::vector<double> m_draws;
+};
+} // namespace libgtfoklahoma
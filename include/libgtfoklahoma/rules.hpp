@@ -20,18 +20,17 @@
 #include "action_model.hpp"
 #include <chrono>
 #include <cstdint>
-#include <random>
+#include <vector>
+
+#include <libgtfoklahoma/rng.hpp>
 
 namespace libgtfoklahoma {
 struct ActionModel;
+struct StatBatch;
 struct StatModel;
 }
 namespace libgtfoklahoma::rules {
 
-static std::random_device rd;
-static std::mt19937 gen(rd());
-static std::uniform_real_distribution<double> randomGenerator(0,1);
-
 #pragma mark - Engine Ticks
 const int32_t kTicksPerGameHour = 120;
 const int32_t kTicksPerRealSecond = 60;
@@ -44,14 +43,19 @@ const int32_t kDefaultWakeupHour = 6;
 const int32_t kDefaultMoneyRemaining = 2000;
 
 /** Action results */
-bool ActionIsSuccessful(const libgtfoklahoma::ActionModel &action);
+bool ActionIsSuccessful(const libgtfoklahoma::ActionModel &action, Rng &rng);
 
 #pragma mark - Safety Constants
 const int32_t kDefaultHealth = 100;
 const double kDefaultOddsHealthIssuePerHour = 0.4;
 const double kDefaultOddsMechanicalIssuePerHour = 0.4;
-bool HealthIssueThisHour(const libgtfoklahoma::StatModel &stats);
-bool MechanicalIssueThisHour(const libgtfoklahoma::StatModel &stats);
+bool HealthIssueThisHour(const libgtfoklahoma::StatModel &stats, Rng &rng);
+bool MechanicalIssueThisHour(const libgtfoklahoma::StatModel &stats, Rng &rng);
+
+// Every rider in the batch at once, `rngs` needs a lane per rider. Rider i
+// gets the same result as the single rider version with lane i's Rng.
+void HealthIssuesThisHour(const libgtfoklahoma::StatBatch &stats, RngBatch &rngs, std::vector<uint8_t> &result);
+void MechanicalIssuesThisHour(const libgtfoklahoma::StatBatch &stats, RngBatch &rngs, std::vector<uint8_t> &result);
 
 #pragma mark - Speed Constants
 /* Weight causes an "exponential decay" in speed
@@ -59,5 +63,6 @@ bool MechanicalIssueThisHour(const libgtfoklahoma::StatModel &stats);
  */
 const double kWeightLambda = 0.004;
 int32_t RealSpeed(const libgtfoklahoma::StatModel &stats);
+void RealSpeeds(const libgtfoklahoma::StatBatch &stats, std::vector<int32_t> &result);
 int32_t TicksUntilNextMile(const libgtfoklahoma::StatModel &stats);
 } // namespace libgtfoklahoma::rules
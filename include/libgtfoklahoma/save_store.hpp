@@ -0,0 +1,77 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace libgtfoklahoma {
+
+class Game;
+
+/**
+ * Persists games to SQLite. The database runs in WAL mode and every call
+ * writes in a single transaction, so saving many games at once costs one
+ * sync rather than one per game.
+ *
+ * save() writes a game out in full. checkpoint() only writes what's changed
+ * since the last save or checkpoint, which during normal play is a single
+ * row plus whatever was bought or happened. Games can't be saved while
+ * they're suspended waiting on the player, since there'd be no way to pick
+ * up where they left off. Those are refused and left unsaved.
+ *
+ * What's changed is tracked per Game rather than per save, so a Game should
+ * only ever be checkpointed to one SaveId. To move it to another, save() it
+ * there in full.
+ */
+class SaveStore {
+public:
+  using SaveId = int64_t;
+  using GameRef = std::pair<SaveId, std::reference_wrapper<Game>>;
+
+  // ":memory:" keeps everything in memory, handy for tests
+  explicit SaveStore(const std::string &path);
+  ~SaveStore();
+
+  // False if the game is waiting on the player
+  bool save(SaveId id, Game &game);
+  bool checkpoint(SaveId id, Game &game);
+  // Games waiting on the player are skipped, the rest are still written.
+  // False if any were skipped.
+  bool checkpoint(const std::vector<GameRef> &games);
+
+  // Action outcomes are rolled up front, so `game` must be freshly constructed
+  // with the save's seed and the same content the save was made with.
+  bool load(SaveId id, Game &game);
+  [[nodiscard]] std::optional<uint64_t> getSeed(SaveId id);
+  [[nodiscard]] bool contains(SaveId id);
+  void remove(SaveId id);
+
+private:
+  static bool canSave(SaveId id, const Game &game);
+  void writeGame(SaveId id, Game &game, bool full);
+
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+} // namespace libgtfoklahoma
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace libgtfoklahoma {
+
+/**
+ * A value with one writer and any number of lock-free readers. Readers copy
+ * the value out and retry if the writer was part way through changing it, so
+ * they never see a torn value and never hold the writer up. Best for small
+ * values that are read far more often than they're written.
+ */
+template<typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value, "SeqLock copies values word by word");
+  static_assert(std::is_default_constructible<T>::value, "SeqLock::load needs somewhere to copy to");
+
+public:
+  explicit SeqLock(const T &value=T())
+  : m_sequence(0) {
+    store(value);
+  }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock &operator=(const SeqLock&) = delete;
+
+  // Only one thread may store at a time
+  void store(const T &value) {
+    Words words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+
+    // An odd sequence tells readers a store is in progress
+    const uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; ++i) {
+      m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  [[nodiscard]] T load() const {
+    Words words{};
+    uint32_t before, after;
+    do {
+      before = m_sequence.load(std::memory_order_acquire);
+      for (size_t i = 0; i < kWords; ++i) {
+        words[i] = m_words[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = m_sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    T value;
+    std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+    return value;
+  }
+
+private:
+  static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  using Words = std::array<uint64_t, kWords>;
+
+  std::atomic<uint32_t> m_sequence;
+  std::array<std::atomic<uint64_t>, kWords> m_words;
+};
+} // namespace libgtfoklahoma
@@ -0,0 +1,167 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <libgtfoklahoma/journal.hpp>
+#include <libgtfoklahoma/rng.hpp>
+#include <libgtfoklahoma/stat_model.hpp>
+
+namespace libgtfoklahoma {
+class Game;
+struct ActionModel;
+struct EventModel;
+struct IssueModel;
+}
+namespace libgtfoklahoma::sim {
+
+/**
+ * Makes the player's decisions during a simulated playthrough. Policies are
+ * only ever used by one playthrough at a time.
+ */
+class IDecisionPolicy {
+public:
+  virtual ~IDecisionPolicy() = default;
+
+  // @return The id of the action to take, must be one of the event's actions
+  virtual int32_t chooseEventAction(Game &game, const EventModel &event) = 0;
+
+  // @return The id of the action to take, must be one of the issue's actions
+  virtual int32_t chooseIssueAction(Game &game, const IssueModel &issue) = 0;
+
+  // Buy whatever you like, the store is left once this returns
+  virtual void shop(Game &game, const ActionModel &store) = 0;
+};
+
+// Picks uniformly between the visible actions and buys a random item, maybe.
+class RandomPolicy : public IDecisionPolicy {
+public:
+  explicit RandomPolicy(uint64_t seed);
+  int32_t chooseEventAction(Game &game, const EventModel &event) override;
+  int32_t chooseIssueAction(Game &game, const IssueModel &issue) override;
+  void shop(Game &game, const ActionModel &store) override;
+
+private:
+  int32_t chooseVisibleAction(Game &game, const std::vector<int32_t> &actionIds);
+  Rng m_rng;
+};
+
+// Picks whichever action has the best expected stat change and buys anything that helps.
+class GreedyPolicy : public IDecisionPolicy {
+public:
+  int32_t chooseEventAction(Game &game, const EventModel &event) override;
+  int32_t chooseIssueAction(Game &game, const IssueModel &issue) override;
+  void shop(Game &game, const ActionModel &store) override;
+
+  // Higher is better. Health and speed are good, weight and bad odds are not.
+  static double Score(const StatModel &delta);
+
+private:
+  int32_t chooseBestAction(Game &game, const std::vector<int32_t> &actionIds);
+};
+
+// Plays back fixed choices, falling back to the first action for anything unscripted.
+class ScriptedPolicy : public IDecisionPolicy {
+public:
+  ScriptedPolicy(std::unordered_map<int32_t, int32_t> eventChoices,
+                 std::unordered_map<int32_t, int32_t> issueChoices,
+                 std::vector<int32_t> itemsToBuy={});
+  int32_t chooseEventAction(Game &game, const EventModel &event) override;
+  int32_t chooseIssueAction(Game &game, const IssueModel &issue) override;
+  void shop(Game &game, const ActionModel &store) override;
+
+private:
+  std::unordered_map<int32_t, int32_t> m_eventChoices;
+  std::unordered_map<int32_t, int32_t> m_issueChoices;
+  std::vector<int32_t> m_itemsToBuy;
+};
+
+// How a single playthrough went
+struct Playthrough {
+  bool completed{false}; // False if it hit the tick limit or got stuck waiting on input
+  bool survived{false};
+  int32_t ending_id{-1};
+  int32_t issues_hit{0};
+  int32_t mile_reached{0};
+  int32_t money_spent{0};
+  uint32_t ticks{0};
+  StatModel final_stats;
+};
+
+// Counts of values, eg: how many playthroughs reached each mile
+struct Histogram {
+  std::map<int64_t, uint64_t> counts;
+  uint64_t total{0};
+
+  void add(int64_t value);
+  void merge(const Histogram &rhs);
+  [[nodiscard]] double mean() const;
+  // @param p In the range [0, 1]
+  [[nodiscard]] int64_t percentile(double p) const;
+};
+
+struct Report {
+  uint64_t playthroughs{0};
+  uint64_t completed{0};
+  uint64_t survived{0};
+  Histogram ending_ids;
+  Histogram issues_hit;
+  Histogram miles_reached;
+  Histogram money_spent;
+
+  void add(const Playthrough &playthrough);
+  void merge(const Report &rhs);
+  [[nodiscard]] double survivalRate() const;
+};
+
+using GameFactory = std::function<std::unique_ptr<Game>(uint64_t seed)>;
+using PolicyFactory = std::function<std::unique_ptr<IDecisionPolicy>(uint64_t seed)>;
+
+struct Options {
+  uint64_t playthroughs{1000};
+  uint64_t seed{0};
+  uint32_t threads{0}; // 0 uses every core
+  uint32_t max_ticks{1000000};
+
+  // Both are handed the playthrough's seed so every run can be reproduced.
+  // Defaults to the built-in content and the random policy. Called from the
+  // simulation threads at the same time, so the games and policies they make
+  // mustn't share anything mutable, eg: an RNG. Sharing a catalog is fine.
+  GameFactory make_game;
+  PolicyFactory make_policy;
+
+  // If set every playthrough is recorded and handed over once it's done.
+  // Called from the simulation threads.
+  std::function<void(uint64_t index, const Journal &journal)> on_journal;
+};
+
+// Plays `game` to the end headlessly, as fast as the CPU allows
+Playthrough Simulate(Game &game, IDecisionPolicy &policy, uint32_t maxTicks);
+
+// Runs every playthrough spread across `options.threads` threads
+Report Run(const Options &options);
+
+// Deterministically derives the seed of the `index`th playthrough
+uint64_t PlaythroughSeed(uint64_t seed, uint64_t index);
+} // namespace libgtfoklahoma::sim
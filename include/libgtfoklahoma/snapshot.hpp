@@ -0,0 +1,53 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace libgtfoklahoma {
+class Game;
+}
+
+/**
+ * Flat binary snapshots of a game's state for moving live sessions between
+ * hosts. A snapshot is a fixed-size POD header followed by the sorted
+ * inventory, the ending hint stack and the happened action and issue ids,
+ * as bitsets or, when they're too spread out for that, sorted lists. So it's
+ * written and read with plain copies out of a single buffer
+ * (or an mmap). Fields are in native byte order; hosts with a different
+ * byte order or layout are rejected rather than misread.
+ */
+namespace libgtfoklahoma::snapshot {
+
+// Bump whenever the header, StatModel or any section changes layout
+const uint16_t kVersion = 3;
+
+// Appends a snapshot of `game` to `out`. Reuse `out` to avoid reallocating.
+void Write(Game &game, std::vector<uint8_t> &out);
+std::vector<uint8_t> Write(Game &game);
+
+// `game` must be freshly constructed with the snapshot's seed and the same
+// content. Its unsaved changes are left alone and don't cover everything that
+// was read, so save() it in full before checkpointing it to a SaveStore.
+bool Read(const uint8_t *data, size_t size, Game &game);
+
+// @return The seed the game in `data` was constructed with
+std::optional<uint64_t> ReadSeed(const uint8_t *data, size_t size);
+} // namespace libgtfoklahoma::snapshot
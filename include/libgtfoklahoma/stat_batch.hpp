@@ -0,0 +1,58 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <libgtfoklahoma/stat_model.hpp>
+
+namespace libgtfoklahoma {
+
+/**
+ * The stats of many riders at once, one array per stat. Batch simulations
+ * step every rider through the same rule together, and keeping each stat
+ * contiguous lets those loops stream through memory and vectorize instead of
+ * hopping from one StatModel to the next.
+ */
+struct StatBatch {
+  std::vector<int32_t> bedtime_hour;
+  std::vector<int32_t> health;
+  std::vector<int32_t> kit_weight;
+  std::vector<int32_t> max_mph;
+  std::vector<int32_t> money_remaining;
+  std::vector<double> odds_health_issue;
+  std::vector<double> odds_mech_issue;
+  std::vector<StatModel::Pace> pace;
+  std::vector<int32_t> wakeup_hour;
+
+  [[nodiscard]] size_t size() const { return health.size(); }
+  void reserve(size_t riders);
+
+  void push_back(const StatModel &stats);
+  [[nodiscard]] StatModel get(size_t rider) const;
+  void set(size_t rider, const StatModel &stats);
+
+  // Applies the same delta to every rider, or only to the riders flagged in
+  // `riders` (e.g. the output of rules::HealthIssuesThisHour). Same semantics
+  // as StatModel::operator+=.
+  void add(const StatModel &delta);
+  void add(const StatModel &delta, const std::vector<uint8_t> &riders);
+};
+} // namespace libgtfoklahoma
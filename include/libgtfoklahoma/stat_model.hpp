@@ -20,7 +20,12 @@
 #include <cstdint>
 
 namespace libgtfoklahoma {
-struct StatModel {
+
+// The ints are grouped ahead of pace and the doubles so an optimizing compiler
+// is free to merge the adds in operator+= into vector adds; nothing relies on it
+// doing so. Snapshots copy this struct as-is, so any layout change needs a
+// snapshot::kVersion bump.
+struct alignas(16) StatModel {
 
   enum class Pace {INVALID, CHILL_AF, FRED, MERCKX};
 
@@ -40,13 +45,17 @@ struct StatModel {
   int32_t kit_weight;
   int32_t max_mph;
   int32_t money_remaining;
-  double odds_health_issue;
-  double odds_mech_issue;
-  Pace pace;
   int32_t wakeup_hour;
+  Pace pace;
+  alignas(16) double odds_health_issue;
+  double odds_mech_issue;
 
 
   bool operator== (const StatModel &rhs) const;
-  StatModel operator+ (const StatModel &rhs);
+  StatModel &operator+= (const StatModel &rhs);
+  [[nodiscard]] StatModel operator+ (const StatModel &rhs) const;
+
+  // The same as adding this delta `times` times over, in one go
+  [[nodiscard]] StatModel operator* (int32_t times) const;
 };
 } // namespace libgtfoklahoma
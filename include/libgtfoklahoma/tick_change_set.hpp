@@ -0,0 +1,46 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+#include <libgtfoklahoma/stat_model.hpp>
+
+namespace libgtfoklahoma {
+
+// Everything that changed over one engine tick, see IEventObserver::onTickCommitted()
+struct TickChangeSet {
+  uint32_t tick{0};
+
+  StatModel stats_before;
+  StatModel stats_after;
+
+  // Item id to the change in quantity. Items that came and went are left out.
+  std::map<int32_t, int32_t> inventory_delta;
+
+  int32_t mile_before{0};
+  int32_t mile_after{0};
+  int32_t hour_before{0};
+  int32_t hour_after{0};
+
+  [[nodiscard]] bool statsChanged() const { return !(stats_before == stats_after); }
+  [[nodiscard]] bool mileChanged() const { return mile_before != mile_after; }
+  [[nodiscard]] bool hourChanged() const { return hour_before != hour_after; }
+};
+} // namespace libgtfoklahoma
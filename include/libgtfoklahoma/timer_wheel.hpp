@@ -0,0 +1,134 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace libgtfoklahoma {
+
+/**
+ * A hashed timer wheel. Scheduling and expiring are O(1) per item no matter
+ * how many items are waiting, which is what lets a handful of threads keep
+ * track of deadlines for a huge number of sessions.
+ *
+ * Items due further out than a single rotation of the wheel simply stay in
+ * their slot until the wheel comes around to their tick.
+ */
+template <typename T>
+class TimerWheel {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  TimerWheel(std::chrono::nanoseconds resolution,
+             size_t slotCount,
+             Clock::time_point start=Clock::now())
+  : m_currentTick(0)
+  , m_nextDueTick(0)
+  , m_nextDueTickIsKnown(true)
+  , m_resolution(std::max(resolution, std::chrono::nanoseconds(1)))
+  , m_size(0)
+  , m_slots(std::max<size_t>(slotCount, 1))
+  , m_start(start) {}
+
+  void schedule(Clock::time_point deadline, T item) {
+    // Anything already due goes in the very next slot to be expired
+    uint64_t tick = m_currentTick;
+    if (deadline > m_start) {
+      auto sinceStart = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - m_start);
+      tick = std::max<uint64_t>(tick, (sinceStart + m_resolution - std::chrono::nanoseconds(1)) / m_resolution);
+    }
+    m_slots[tick % m_slots.size()].push_back({tick, std::move(item)});
+    if (!m_size) {
+      m_nextDueTick = tick;
+      m_nextDueTickIsKnown = true;
+    } else if (m_nextDueTickIsKnown) {
+      m_nextDueTick = std::min(m_nextDueTick, tick);
+    }
+    m_size++;
+  }
+
+  // Moves everything that is due by `now` into `due`
+  void advance(Clock::time_point now, std::vector<T> &due) {
+    if (now < m_start) { return; }
+    uint64_t targetTick = (now - m_start) / m_resolution;
+    if (targetTick < m_currentTick) { return; }
+
+    // After a long gap every slot gets visited exactly once
+    auto slotsToVisit = std::min<uint64_t>(targetTick - m_currentTick + 1, m_slots.size());
+    for (uint64_t i = 0; i < slotsToVisit; i++) {
+      auto &slot = m_slots[(m_currentTick + i) % m_slots.size()];
+      for (size_t j = 0; j < slot.size();) {
+        if (slot[j].tick > targetTick) { j++; continue; }
+        due.push_back(std::move(slot[j].item));
+        slot[j] = std::move(slot.back());
+        slot.pop_back();
+        m_size--;
+      }
+    }
+    m_currentTick = targetTick + 1;
+    m_nextDueTickIsKnown = false;
+  }
+
+  // When the earliest item is due. Empty slots are skipped so whoever waits
+  // on this isn't woken up every tick while nothing is due.
+  [[nodiscard]] Clock::time_point nextExpiry() const {
+    return m_start + m_resolution * nextDueTick();
+  }
+
+  [[nodiscard]] std::chrono::nanoseconds getResolution() const { return m_resolution; }
+  [[nodiscard]] size_t size() const { return m_size; }
+
+private:
+  struct Entry {
+    uint64_t tick;
+    T item;
+  };
+
+  uint64_t nextDueTick() const {
+    if (!m_size) { return m_currentTick; }
+    if (m_nextDueTickIsKnown) { return m_nextDueTick; }
+
+    // Slots come up in order, so the first one holding something due this
+    // rotation has the earliest item. Otherwise everything is at least a
+    // rotation out and it's whichever is soonest.
+    const auto rotationEnd = m_currentTick + m_slots.size();
+    uint64_t earliest = UINT64_MAX;
+    for (auto tick = m_currentTick; tick < rotationEnd && earliest >= rotationEnd; tick++) {
+      for (const auto &entry : m_slots[tick % m_slots.size()]) {
+        earliest = std::min(earliest, entry.tick);
+      }
+    }
+    m_nextDueTick = std::max(earliest, m_currentTick);
+    m_nextDueTickIsKnown = true;
+    return m_nextDueTick;
+  }
+
+  uint64_t m_currentTick;
+  // Cached, scheduling only ever brings it forward
+  mutable uint64_t m_nextDueTick;
+  mutable bool m_nextDueTickIsKnown;
+  std::chrono::nanoseconds m_resolution;
+  size_t m_size;
+  std::vector<std::vector<Entry>> m_slots;
+  Clock::time_point m_start;
+};
+} // namespace libgtfoklahoma
@@ -40,10 +40,10 @@ public:
   void onGameOver(const libgtfoklahoma::EndingModel &ending) override;
   void onHourChanged(int32_t hour) override;
   void onMileChanged(int32_t mile) override;
-  bool onEvent(libgtfoklahoma::EventModel &event) override;
-  bool onIssueOccurred(libgtfoklahoma::IssueModel &issue) override;
+  bool onEvent(const libgtfoklahoma::EventModel &event) override;
+  bool onIssueOccurred(const libgtfoklahoma::IssueModel &issue) override;
   void onStatsChanged(const libgtfoklahoma::StatModel &stats) override;
-  bool onStoreEntered(libgtfoklahoma::ActionModel &action) override;
+  bool onStoreEntered(const libgtfoklahoma::ActionModel &action) override;
 
 private:
   Ui &m_ui;
@@ -43,13 +43,13 @@ public:
   /** Things that happen in the main window **/
   [[nodiscard]] const Window &mainWindow() const;
   void renderEvent(const libgtfoklahoma::EventModel &event,
-                   const std::vector<std::reference_wrapper<libgtfoklahoma::ActionModel>> &actions);
+                   const std::vector<std::reference_wrapper<const libgtfoklahoma::ActionModel>> &actions);
 
   void renderIssue(const libgtfoklahoma::IssueModel &issue,
-                   const std::vector<std::reference_wrapper<libgtfoklahoma::ActionModel>> &actions);
+                   const std::vector<std::reference_wrapper<const libgtfoklahoma::ActionModel>> &actions);
 
   void renderStore(const libgtfoklahoma::ActionModel &action,
-                   const std::vector<std::reference_wrapper<libgtfoklahoma::ItemModel>> &items);
+                   const std::vector<std::reference_wrapper<const libgtfoklahoma::ItemModel>> &items);
 
   /** Things that happen in the inventory window **/
   [[nodiscard]] const Window &inventoryWindow() const;
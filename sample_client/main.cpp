@@ -53,7 +53,8 @@ int main(int argc, char *argv[]) {
   libgtfoklahoma::Game game("");
   auto eventObserver = std::make_unique<gtfoklahoma::EventObserver>(game, ui);
   game.registerEventObserver(std::move(eventObserver));
-  ui.renderBeginGame(game.getStats().getPlayerStatsModel(), game.getCurrentMile(), game.getCurrentHour());
+  const auto state = game.getPlayerState();
+  ui.renderBeginGame(state.stats, state.mile, state.hour);
 
   auto engine = std::make_unique<libgtfoklahoma::Engine>(game);
   engine->start();
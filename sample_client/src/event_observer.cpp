@@ -45,18 +45,20 @@ void EventObserver::onGameOver(const libgtfoklahoma::EndingModel &ending) {}
 
 void EventObserver::onHourChanged(int32_t hour) {
   spdlog::debug("Current hour is {}", hour);
-  m_ui.renderStats(m_game.getStats().getPlayerStatsModel(), m_game.getCurrentMile(), hour);
+  const auto state = m_game.getPlayerState();
+  m_ui.renderStats(state.stats, state.mile, hour);
 }
 
 void EventObserver::onMileChanged(int32_t mile) {
   spdlog::debug("Current mile is {}", mile);
-  m_ui.renderStats(m_game.getStats().getPlayerStatsModel(), mile, m_game.getCurrentHour());
+  const auto state = m_game.getPlayerState();
+  m_ui.renderStats(state.stats, mile, state.hour);
 }
 
-bool EventObserver::onEvent(EventModel &event) {
+bool EventObserver::onEvent(const EventModel &event) {
   spdlog::debug("POI Encountered-> " + event.display_name);
 
-  std::vector<std::reference_wrapper<ActionModel>> actions;
+  std::vector<std::reference_wrapper<const ActionModel>> actions;
   for (const auto &actionId : event.action_ids) {
     actions.emplace_back(m_game.getActions().getAction(actionId));
   }
@@ -71,14 +73,14 @@ bool EventObserver::onEvent(EventModel &event) {
   };
 
   auto result = UIUtils::getInputInt(m_ui.inputBar(),"Please enter a number-> ", validator);
-  event.chooseAction(actions.at(result).get().id);
+  m_game.getEvents().chooseAction(event.id, actions.at(result).get().id);
   return true;
 }
 
-bool EventObserver::onIssueOccurred(libgtfoklahoma::IssueModel &issue) {
+bool EventObserver::onIssueOccurred(const libgtfoklahoma::IssueModel &issue) {
   spdlog::debug("Issue {} occurred", issue.id);
 
-  std::vector<std::reference_wrapper<ActionModel>> actions;
+  std::vector<std::reference_wrapper<const ActionModel>> actions;
   for (const auto &actionId : issue.actions) {
     actions.emplace_back(m_game.getActions().getAction(actionId));
   }
@@ -93,18 +95,19 @@ bool EventObserver::onIssueOccurred(libgtfoklahoma::IssueModel &issue) {
   };
 
   auto result = UIUtils::getInputInt(m_ui.inputBar(),"Please enter a number-> ", validator);
-  issue.chooseAction(actions.at(result).get().id);
+  m_game.getIssues().chooseAction(issue.id, actions.at(result).get().id);
   return true;
 }
 
 void EventObserver::onStatsChanged(const libgtfoklahoma::StatModel &stats) {
-  m_ui.renderStats(stats, m_game.getCurrentMile(), m_game.getCurrentHour());
+  const auto state = m_game.getPlayerState();
+  m_ui.renderStats(stats, state.mile, state.hour);
 }
 
-bool EventObserver::onStoreEntered(ActionModel &action) {
+bool EventObserver::onStoreEntered(const ActionModel &action) {
   spdlog::debug("Entered a store!");
 
-  std::vector<std::reference_wrapper<ItemModel>> items;
+  std::vector<std::reference_wrapper<const ItemModel>> items;
   for (const auto &itemId : action.item_ids) {
     items.emplace_back(m_game.getItems().getItem(itemId));
   }
@@ -113,11 +116,11 @@ bool EventObserver::onStoreEntered(ActionModel &action) {
 
   // Convert the choice into an item id and ensure its a valid item id
   // If the response is valid, attempt to purchase the item.
-  const auto validator = [&action, &items]  (int32_t i) -> bool {
+  const auto validator = [this, &action, &items]  (int32_t i) -> bool {
     if (i > items.size()) { return false; }
     if (i == items.size()) { return true; } // Is "Leave Store" item.
     auto id = items.at(i).get().id;
-    return (action.itemIsInStock(id) && action.purchaseItem(items.at(i).get().id));
+    return (action.itemIsInStock(id) && m_game.getActions().purchaseItem(action.id, items.at(i).get().id));
   };
 
   int32_t result = -1;
@@ -130,6 +133,6 @@ bool EventObserver::onStoreEntered(ActionModel &action) {
   }
   spdlog::debug("Purchase complete");
   spdlog::default_logger()->flush();
-  action.completePurchase();
+  m_game.getActions().completePurchase(action.id);
   return true;
 }
@@ -124,7 +124,7 @@ void Ui::renderBeginGame(const libgtfoklahoma::StatModel &initialStats,
 
 void Ui::renderEvent(
     const libgtfoklahoma::EventModel &event,
-    const std::vector<std::reference_wrapper<libgtfoklahoma::ActionModel>> &actions) {
+    const std::vector<std::reference_wrapper<const libgtfoklahoma::ActionModel>> &actions) {
 
   std::vector<std::string> actionNames;
   actionNames.reserve(actions.size());
@@ -143,7 +143,7 @@ void Ui::renderEvent(
 
 void Ui::renderIssue(
     const libgtfoklahoma::IssueModel &issue,
-    const std::vector<std::reference_wrapper<libgtfoklahoma::ActionModel>>
+    const std::vector<std::reference_wrapper<const libgtfoklahoma::ActionModel>>
         &actions) {
 
   std::vector<std::string> actionNames;
@@ -163,7 +163,7 @@ void Ui::renderIssue(
 
 void Ui::renderStore(
     const libgtfoklahoma::ActionModel &action,
-    const std::vector<std::reference_wrapper<libgtfoklahoma::ItemModel>>
+    const std::vector<std::reference_wrapper<const libgtfoklahoma::ItemModel>>
         &items) {
 
   std::vector<std::string> itemNames;
@@ -0,0 +1,209 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Library includes
+#include <libgtfoklahoma/content_catalog.hpp>
+#include <libgtfoklahoma/content_pack.hpp>
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/journal.hpp>
+#include <libgtfoklahoma/simulator.hpp>
+
+// System Includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 3P includes
+#include <spdlog/spdlog.h>
+
+using namespace libgtfoklahoma;
+
+namespace {
+void printUsage(const char *name) {
+  std::printf("Usage: %s [options]\n"
+              "  --runs N                  Number of playthroughs (default 1000)\n"
+              "  --threads N               Worker threads, 0 for every core (default 0)\n"
+              "  --seed N                  Seed for the whole batch (default 0)\n"
+              "  --policy random|greedy|scripted\n"
+              "  --event ID=ACTION         Scripted policy: action to take for an event\n"
+              "  --issue ID=ACTION         Scripted policy: action to take for an issue\n"
+              "  --buy ITEM                Scripted policy: item to buy at every store\n"
+              "  --content DIR             Play with the content pack in DIR instead of the built-in content\n"
+              "  --record DIR              Write a journal of every playthrough to DIR\n"
+              "  --verbose                 Show the library's logging\n"
+              "   or: %s --replay JOURNAL...\n"
+              "  Replays recorded playthroughs and checks they still end the same way\n",
+              name, name);
+}
+
+bool parseChoice(const char *arg, std::unordered_map<int32_t, int32_t> &choices) {
+  auto separator = std::strchr(arg, '=');
+  if (!separator) { return false; }
+  choices[std::atoi(arg)] = std::atoi(separator + 1);
+  return true;
+}
+
+void printHistogram(const char *name, const sim::Histogram &histogram) {
+  std::printf("%-14s mean %8.2f  min %6lld  p10 %6lld  p50 %6lld  p90 %6lld  max %6lld\n",
+              name,
+              histogram.mean(),
+              static_cast<long long>(histogram.percentile(0)),
+              static_cast<long long>(histogram.percentile(0.1)),
+              static_cast<long long>(histogram.percentile(0.5)),
+              static_cast<long long>(histogram.percentile(0.9)),
+              static_cast<long long>(histogram.percentile(1)));
+}
+}
+
+int replayJournals(const std::vector<std::string> &paths, const std::shared_ptr<const ContentCatalog> &catalog) {
+  auto begin = std::chrono::steady_clock::now();
+  size_t failures = 0;
+  for (const auto &path : paths) {
+    auto journal = Journal::ReadFromFile(path);
+    if (!journal) {
+      std::printf("%s: unreadable\n", path.c_str());
+      failures++;
+      continue;
+    }
+    Game game("replay", catalog, journal->getSeed());
+    auto result = Replay(*journal, game);
+    if (!result.matches) {
+      std::printf("%s: %s\n", path.c_str(), result.mismatch.c_str());
+      failures++;
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+  std::printf("Replayed %zu journals in %.2fs, %zu failed\n", paths.size(), elapsed.count(), failures);
+  return failures ? 1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+  sim::Options options;
+  std::string policy = "random";
+  std::unordered_map<int32_t, int32_t> eventChoices;
+  std::unordered_map<int32_t, int32_t> issueChoices;
+  std::vector<int32_t> itemsToBuy;
+  std::string contentDir;
+  std::string recordDir;
+  std::vector<std::string> replayPaths;
+  bool verbose = false;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--runs" && hasValue) {
+      options.playthroughs = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--threads" && hasValue) {
+      options.threads = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--seed" && hasValue) {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--policy" && hasValue) {
+      policy = argv[++i];
+    } else if (arg == "--event" && hasValue && parseChoice(argv[i + 1], eventChoices)) {
+      i++;
+    } else if (arg == "--issue" && hasValue && parseChoice(argv[i + 1], issueChoices)) {
+      i++;
+    } else if (arg == "--buy" && hasValue) {
+      itemsToBuy.push_back(std::atoi(argv[++i]));
+    } else if (arg == "--content" && hasValue) {
+      contentDir = argv[++i];
+    } else if (arg == "--record" && hasValue) {
+      recordDir = argv[++i];
+    } else if (arg == "--replay" && hasValue) {
+      replayPaths.assign(argv + i + 1, argv + argc);
+      break;
+    } else if (arg == "--verbose") {
+      verbose = true;
+    } else {
+      printUsage(argv[0]);
+      return arg == "--help" ? 0 : 1;
+    }
+  }
+
+  // Every playthrough logs, which swamps the output and slows everything down
+  spdlog::set_level(verbose ? spdlog::level::debug : spdlog::level::off);
+
+  // Every playthrough shares the one catalog
+  auto catalog = ContentCatalog::BuiltIn();
+  if (!contentDir.empty()) {
+    auto pack = ContentPack::LoadDirectory(contentDir);
+    if (!pack) {
+      std::printf("Unable to load content from %s\n", contentDir.c_str());
+      return 1;
+    }
+    catalog = ContentCatalog::FromPack(*pack);
+  }
+  options.make_game = [catalog](uint64_t seed) {
+    return std::make_unique<Game>("simulation", catalog, seed);
+  };
+
+  if (!replayPaths.empty()) {
+    return replayJournals(replayPaths, catalog);
+  }
+
+  if (!recordDir.empty()) {
+    options.on_journal = [&recordDir](uint64_t index, const Journal &journal) {
+      journal.writeToFile(recordDir + "/" + std::to_string(index) + ".journal");
+    };
+  }
+
+  if (policy == "random") {
+    options.make_policy = [](uint64_t seed) {
+      return std::unique_ptr<sim::IDecisionPolicy>(std::make_unique<sim::RandomPolicy>(seed));
+    };
+  } else if (policy == "greedy") {
+    options.make_policy = [](uint64_t) {
+      return std::unique_ptr<sim::IDecisionPolicy>(std::make_unique<sim::GreedyPolicy>());
+    };
+  } else if (policy == "scripted") {
+    options.make_policy = [&](uint64_t) {
+      return std::unique_ptr<sim::IDecisionPolicy>(
+          std::make_unique<sim::ScriptedPolicy>(eventChoices, issueChoices, itemsToBuy));
+    };
+  } else {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  auto begin = std::chrono::steady_clock::now();
+  auto report = sim::Run(options);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+  std::printf("%llu playthroughs (%s policy) in %.2fs, %.0f/s\n",
+              static_cast<unsigned long long>(report.playthroughs),
+              policy.c_str(),
+              elapsed.count(),
+              report.playthroughs / std::max(elapsed.count(), 1e-9));
+  std::printf("Survival rate  %.2f%% (%llu finished, %llu cut off)\n",
+              100 * report.survivalRate(),
+              static_cast<unsigned long long>(report.completed),
+              static_cast<unsigned long long>(report.playthroughs - report.completed));
+  printHistogram("Mile reached", report.miles_reached);
+  printHistogram("Money spent", report.money_spent);
+  printHistogram("Issues hit", report.issues_hit);
+  std::printf("Endings\n");
+  for (const auto &[endingId, count] : report.ending_ids.counts) {
+    std::printf("  %-12lld %llu\n", static_cast<long long>(endingId), static_cast<unsigned long long>(count));
+  }
+  return 0;
+}
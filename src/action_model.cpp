@@ -17,53 +17,15 @@
 
 #include <libgtfoklahoma/action_model.hpp>
 
-#include <spdlog/spdlog.h>
-
-#include <libgtfoklahoma/actions.hpp>
-#include <libgtfoklahoma/game.hpp>
+#include <algorithm>
 
 using namespace libgtfoklahoma;
 
-ActionModel::ActionModel(Game &game)
-: m_successful(false)
-, m_game(game) {}
-
-bool ActionModel::isVisible() {
-  for (const auto &dependent_inventory_id : dependent_inventory_ids) {
-    if (!(m_game.inventoryCount(dependent_inventory_id.first) >=
-        dependent_inventory_id.second)) {
-      return false;
-    }
-  }
-  return true;
-}
-
-bool ActionModel::failed() const {
-  return !m_successful;
-}
-
-void ActionModel::completePurchase() { m_purchaseComplete.set_value(); }
-
 bool ActionModel::itemIsInStock(int32_t itemId) const {
   if (!isStoreType()) { return false; }
   return std::find(item_ids.begin(), item_ids.end(), itemId) != item_ids.end();
 }
 
-bool ActionModel::purchaseItem(int32_t id_to_buy) {
-  auto &item = m_game.getItems().getItem(id_to_buy);
-  auto &stats = m_game.getStats().getPlayerStatsModel();
-  if (item.cost > stats.money_remaining) {
-    spdlog::debug("Your broke ass can't afford this item!");
-    return false;
-  }
-  m_game.addItemToInventory(id_to_buy);
-  return true;
-}
-
-std::future<void> ActionModel::purchaseComplete() {
-  return m_purchaseComplete.get_future();
-}
-
 bool ActionModel::operator==(const ActionModel &rhs) const {
   return this->id == rhs.id &&
          this->display_name == rhs.display_name &&
@@ -19,135 +19,34 @@
 
 #include <utility>
 
-#include <rapidjson/document.h>
 #include <spdlog/spdlog.h>
 
+#include <libgtfoklahoma/content_catalog.hpp>
 #include <libgtfoklahoma/event_observer.hpp>
 #include <libgtfoklahoma/game.hpp>
 #include <libgtfoklahoma/items.hpp>
 
 using namespace libgtfoklahoma;
 
-Actions::Actions(Game &game, const char *actionJson)
-: kEmptyActionModel(game)
-, m_game(game) {
-
-  rapidjson::Document actionsDocument;
-  if (actionsDocument.Parse(actionJson).HasParseError() ||
-      !actionsDocument.IsArray()) {
-    spdlog::error("Parsing error when parsing actions json");
-    abort();
-  }
-
-  auto actionIsValid = [] (const rapidjson::Value &action) {
-    return action.HasMember("display_name") && action["display_name"].IsString() &&
-           action.HasMember("id") && action["id"].IsInt() &&
-           action.HasMember("type") && action["type"].IsArray();
-  };
-
-  auto getActionType = [](const rapidjson::GenericArray<true, rapidjson::Value> &arr) {
-    uint32_t type = 0;
-    for (const auto &elem : arr) {
-      if (!elem.IsString()) {
-        spdlog::warn("Error parsing action type");
-        continue;
-      }
-
-      auto str_value = elem.GetString();
-      if (!strcmp(str_value, "NONE")) {
-        type |= ActionModel::ActionType::NONE;
-      }
-
-      else if (!strcmp(str_value, "STAT_CHANGE")) {
-        type |= ActionModel::ActionType::STAT_CHANGE;
-      }
-
-      else if (!strcmp(str_value, "STORE")) {
-        type |= ActionModel::ActionType::STORE;
-      }
-    }
-    return type;
-  };
-
-  for (const auto &action : actionsDocument.GetArray()) {
-    if (actionIsValid(action)) {
-      auto &model = m_actions.emplace(action["id"].GetInt(), ActionModel(m_game)).first->second;
-
-      model.id = action["id"].GetInt();
-
-      if (action.HasMember("dependent_inventory_ids") && action["dependent_inventory_ids"].IsArray()) {
-        for (const auto &dependentInventoryId : action["dependent_inventory_ids"].GetArray()) {
-          auto pair = dependentInventoryId.GetObject();
-          if (pair.HasMember("id") && pair["id"].IsInt()
-              && pair.HasMember("qty") && pair["qty"].IsInt()) {
-            model.dependent_inventory_ids.emplace_back(pair["id"].GetInt(), pair["qty"].GetInt());
-          }
-        }
-      }
-
-      model.display_name = action["display_name"].GetString();
-      model.type = getActionType(action["type"].GetArray());
-
-      if (action.HasMember("ending_id_hints") && action["ending_id_hints"].IsArray()) {
-        for (const auto &endingId : action["ending_id_hints"].GetArray()) {
-          model.ending_id_hints.emplace_back(endingId.GetInt());
-        }
-      }
-
-      if (model.isStatChangeType() && action.HasMember("success_chance")) {
-        model.can_fail = true;
-        model.success_chance = action["success_chance"].GetFloat();
-      }
-
-      if (model.isStatChangeType() && action.HasMember("message_failure")) {
-        model.message_failure = action["message_failure"].GetString();
-      }
-
-      if (model.isStatChangeType() && action.HasMember("message_success")) {
-        model.message_success = action["message_success"].GetString();
-      }
-
-      if (model.isStatChangeType() && action.HasMember("stat_changes_on_failure")){
-        model.stat_delta_on_failure = Stats::FromJson(action["stat_changes_on_failure"].GetArray());
-      }
-
-      if (model.isStatChangeType() && action.HasMember("stat_changes_on_success")){
-        model.stat_delta_on_success = Stats::FromJson(action["stat_changes_on_success"].GetArray());
-      }
-
-      if (model.isStatChangeType() && action.HasMember("stat_changes_regardless")){
-        model.stat_delta_regardless = Stats::FromJson(action["stat_changes_regardless"].GetArray());
-      }
-
-      if (model.isStoreType() && action.HasMember("items")) {
-        for (const auto &id : action["items"].GetArray()) {
-          model.item_ids.push_back(id.GetInt());
-        }
-      }
-
-    } else {
-      spdlog::error("Parsing error when adding an action");
-    }
-  }
-
+Actions::Actions(Game &game, const ContentCatalog &catalog)
+: m_game(game)
+, m_catalog(catalog) {
   // Determine all action outcomes now because free-will isn't real.
-  for (auto &action_id_pair : m_actions) {
-    auto &action = action_id_pair.second;
-      action.m_successful = rules::ActionIsSuccessful(action);
+  for (const auto &action : m_catalog.getActions()) {
+    if (rules::ActionIsSuccessful(action, m_game.getActionRng())) {
+      m_successfulActionIds.insert(action.id);
+    }
   }
 }
 
-ActionModel &Actions::getAction(int32_t id) {
-  if (m_actions.count(id)) {
-    return m_actions.at(id);
-  }
-
-  spdlog::warn("Requested action id {} that does not exist.", id);
-  return kEmptyActionModel;
+const ActionModel &Actions::getAction(int32_t id) const {
+  return m_catalog.getAction(id);
 }
 
-void Actions::handleAction(int32_t id, const std::shared_ptr<IEventObserver> &observer) {
-  ActionModel &action = getAction(id);
+void Actions::handleAction(int32_t id,
+                           const std::shared_ptr<IEventObserver> &observer,
+                           std::function<void()> then) {
+  const ActionModel &action = getAction(id);
   spdlog::debug("Performing action {}", id);
 
   // If this action causes the game to end, hint to the engine how it should go down
@@ -158,24 +57,72 @@ void Actions::handleAction(int32_t id, const std::shared_ptr<IEventObserver> &ob
   // Update stats if this action has stat changes associated with it
   if (action.isStatChangeType()) {
     m_game.updateStats(action.stat_delta_regardless);
-    if (action.can_fail && action.failed()) {
+    if (action.can_fail && actionFailed(id)) {
       m_game.updateStats(action.stat_delta_on_failure);
     } else if (action.can_fail) {
       m_game.updateStats(action.stat_delta_on_success);
     }
   }
 
-  // If the action is a store (weird design but it works), block until
-  // the player has left the store
+  // There are entities that are dependent on actions having happened
+  // eg: "You can only explode if someone has previously set us up the bomb"
+  // so track what has happened
+  auto markAsHappened = [this, id, then]() {
+    if (m_actionsThatHaveAlreadyHappened.insert(id).second) {
+      m_game.getUnsavedChanges().happened_action_ids.push_back(id);
+      m_game.getIssues().actionHappened(id);
+    }
+    if (then) { then(); }
+  };
+
+  // If the action is a store (weird design but it works), the action isn't
+  // complete until the player has left the store
   if (action.isStoreType()) {
+    auto &leftStore = m_purchasesComplete.ask(id);
     observer->onStoreEntered(action);
-    action.purchaseComplete().get();
+    m_game.awaitInput(leftStore, [this, id, markAsHappened]() {
+      m_game.recordInput({JournalEntry::Type::LEAVE_STORE, id});
+      markAsHappened();
+    });
+    return;
   }
 
-  // There are entities that are dependent on actions having happened
-  // eg: "You can only explode if someone has previously set us up the bomb"
-  // so track what has happened
-  m_actionsThatHaveAlreadyHappened.insert(id);
+  markAsHappened();
+}
+
+bool Actions::actionFailed(int32_t id) const {
+  return !m_successfulActionIds.count(id);
+}
+
+bool Actions::isVisible(int32_t id) const {
+  for (const auto &dependent_inventory_id : getAction(id).dependent_inventory_ids) {
+    if (!(m_game.inventoryCount(dependent_inventory_id.first) >=
+        dependent_inventory_id.second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Actions::purchaseItem(int32_t storeId, int32_t itemId) {
+  auto &item = m_game.getItems().getItem(itemId);
+  auto &stats = m_game.getStats().getPlayerStatsModel();
+  if (item.cost > stats.money_remaining) {
+    spdlog::debug("Your broke ass can't afford this item!");
+    return false;
+  }
+  m_game.addItemToInventory(itemId);
+  m_game.recordInput({JournalEntry::Type::PURCHASE, storeId, itemId});
+
+  // Shopping can take a while, let the player see their money go down as they go
+  m_game.flushTick();
+  return true;
+}
+
+void Actions::completePurchase(int32_t storeId) { purchaseComplete(storeId).decide(true); }
+
+Decision<bool> &Actions::purchaseComplete(int32_t storeId) {
+  return m_purchasesComplete.get(storeId);
 }
 
 bool Actions::actionHasHappened(int32_t actionId) {
@@ -184,4 +131,9 @@ bool Actions::actionHasHappened(int32_t actionId) {
 
 void Actions::setActionsThatHaveAlreadyHappened(std::unordered_set<int32_t> actionIds) {
   m_actionsThatHaveAlreadyHappened = std::move(actionIds);
+  m_game.getIssues().actionsChanged();
+}
+
+const std::unordered_set<int32_t> &Actions::getActionsThatHaveAlreadyHappened() const {
+  return m_actionsThatHaveAlreadyHappened;
 }
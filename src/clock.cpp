@@ -0,0 +1,103 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/clock.hpp>
+
+#include <algorithm>
+
+using namespace libgtfoklahoma;
+
+IClock::TimePoint SteadyClock::now() const {
+  return std::chrono::steady_clock::now();
+}
+
+bool SteadyClock::waitUntil(std::unique_lock<std::mutex> &lock,
+                            std::condition_variable &wakeup,
+                            TimePoint deadline,
+                            const std::function<bool()> &stop) {
+  return wakeup.wait_until(lock, deadline, stop);
+}
+
+VirtualClock::VirtualClock(Mode mode, TimePoint start)
+: m_mode(mode)
+, m_now(start.time_since_epoch().count()) {}
+
+IClock::TimePoint VirtualClock::now() const {
+  return TimePoint(TimePoint::duration(m_now.load()));
+}
+
+bool VirtualClock::waitUntil(std::unique_lock<std::mutex> &lock,
+                             std::condition_variable &wakeup,
+                             TimePoint deadline,
+                             const std::function<bool()> &stop) {
+  addWaiter(lock, wakeup);
+  while (!stop() && now() < deadline) {
+    if (m_mode == Mode::ADVANCE_WHEN_WAITING) {
+      // Looks like a spurious wake up to the caller
+      lock.unlock();
+      advanceTo(deadline);
+      lock.lock();
+      continue;
+    }
+    wakeup.wait(lock);
+  }
+  removeWaiter(lock, wakeup);
+  return stop();
+}
+
+void VirtualClock::advance(std::chrono::nanoseconds duration) {
+  advanceTo(now() + std::chrono::duration_cast<TimePoint::duration>(duration));
+}
+
+void VirtualClock::advanceTo(TimePoint time) {
+  std::lock_guard<std::mutex> lock(m_waitersMutex);
+  if (time <= now()) { return; }
+  m_now = time.time_since_epoch().count();
+
+  // Taking each waiter's lock means they are either about to check the time
+  // or already waiting to be told about it
+  for (const auto &waiter : m_waiters) {
+    std::lock_guard<std::mutex> waiterLock(*waiter.mutex);
+    waiter.wakeup->notify_all();
+  }
+}
+
+size_t VirtualClock::waiterCount() const {
+  std::lock_guard<std::mutex> lock(m_waitersMutex);
+  return m_waiters.size();
+}
+
+void VirtualClock::addWaiter(std::unique_lock<std::mutex> &lock, std::condition_variable &wakeup) {
+  lock.unlock();
+  {
+    std::lock_guard<std::mutex> waitersLock(m_waitersMutex);
+    m_waiters.push_back({lock.mutex(), &wakeup});
+  }
+  lock.lock();
+}
+
+void VirtualClock::removeWaiter(std::unique_lock<std::mutex> &lock, std::condition_variable &wakeup) {
+  lock.unlock();
+  {
+    std::lock_guard<std::mutex> waitersLock(m_waitersMutex);
+    auto it = std::find_if(m_waiters.begin(), m_waiters.end(), [&](const Waiter &waiter) {
+      return waiter.mutex == lock.mutex() && waiter.wakeup == &wakeup;
+    });
+    if (it != m_waiters.end()) { m_waiters.erase(it); }
+  }
+  lock.lock();
+}
@@ -0,0 +1,423 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/content_catalog.hpp>
+
+// System includes
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+// 3P Includes
+#include <rapidjson/document.h>
+#include <spdlog/spdlog.h>
+
+// Local includes
+#include <libgtfoklahoma/stats.hpp>
+
+using namespace libgtfoklahoma;
+
+namespace {
+std::vector<int32_t> idsFromArray(const rapidjson::GenericArray<true, rapidjson::Value> &arr) {
+  std::vector<int32_t> result;
+  for (const auto &id : arr) {
+    result.emplace_back(id.GetInt());
+  }
+  return result;
+}
+
+std::map<int32_t, ActionModel> parseActions(const rapidjson::Value &actionsDocument) {
+  if (!actionsDocument.IsArray()) {
+    spdlog::error("Parsing error when parsing actions json");
+    abort();
+  }
+
+  std::map<int32_t, ActionModel> actions;
+  auto actionIsValid = [] (const rapidjson::Value &action) {
+    return action.HasMember("display_name") && action["display_name"].IsString() &&
+           action.HasMember("id") && action["id"].IsInt() &&
+           action.HasMember("type") && action["type"].IsArray();
+  };
+
+  auto getActionType = [](const rapidjson::GenericArray<true, rapidjson::Value> &arr) {
+    uint32_t type = 0;
+    for (const auto &elem : arr) {
+      if (!elem.IsString()) {
+        spdlog::warn("Error parsing action type");
+        continue;
+      }
+
+      auto str_value = elem.GetString();
+      if (!strcmp(str_value, "NONE")) {
+        type |= ActionModel::ActionType::NONE;
+      }
+
+      else if (!strcmp(str_value, "STAT_CHANGE")) {
+        type |= ActionModel::ActionType::STAT_CHANGE;
+      }
+
+      else if (!strcmp(str_value, "STORE")) {
+        type |= ActionModel::ActionType::STORE;
+      }
+    }
+    return type;
+  };
+
+  for (const auto &action : actionsDocument.GetArray()) {
+    if (!actionIsValid(action)) {
+      spdlog::error("Parsing error when adding an action");
+      continue;
+    }
+
+    auto &model = actions[action["id"].GetInt()];
+    model.id = action["id"].GetInt();
+
+    if (action.HasMember("dependent_inventory_ids") && action["dependent_inventory_ids"].IsArray()) {
+      for (const auto &dependentInventoryId : action["dependent_inventory_ids"].GetArray()) {
+        auto pair = dependentInventoryId.GetObject();
+        if (pair.HasMember("id") && pair["id"].IsInt()
+            && pair.HasMember("qty") && pair["qty"].IsInt()) {
+          model.dependent_inventory_ids.emplace_back(pair["id"].GetInt(), pair["qty"].GetInt());
+        }
+      }
+    }
+
+    model.display_name = action["display_name"].GetString();
+    model.type = getActionType(action["type"].GetArray());
+
+    if (action.HasMember("ending_id_hints") && action["ending_id_hints"].IsArray()) {
+      model.ending_id_hints = idsFromArray(action["ending_id_hints"].GetArray());
+    }
+
+    if (model.isStatChangeType() && action.HasMember("success_chance")) {
+      model.can_fail = true;
+      model.success_chance = action["success_chance"].GetFloat();
+    }
+
+    if (model.isStatChangeType() && action.HasMember("message_failure")) {
+      model.message_failure = action["message_failure"].GetString();
+    }
+
+    if (model.isStatChangeType() && action.HasMember("message_success")) {
+      model.message_success = action["message_success"].GetString();
+    }
+
+    if (model.isStatChangeType() && action.HasMember("stat_changes_on_failure")){
+      model.stat_delta_on_failure = Stats::FromJson(action["stat_changes_on_failure"].GetArray());
+    }
+
+    if (model.isStatChangeType() && action.HasMember("stat_changes_on_success")){
+      model.stat_delta_on_success = Stats::FromJson(action["stat_changes_on_success"].GetArray());
+    }
+
+    if (model.isStatChangeType() && action.HasMember("stat_changes_regardless")){
+      model.stat_delta_regardless = Stats::FromJson(action["stat_changes_regardless"].GetArray());
+    }
+
+    if (model.isStoreType() && action.HasMember("items")) {
+      model.item_ids = idsFromArray(action["items"].GetArray());
+    }
+  }
+  return actions;
+}
+
+std::map<int32_t, EndingModel> parseEndings(const rapidjson::Value &endingsDocument) {
+  if (!endingsDocument.IsArray()) {
+    spdlog::error("Parsing error when parsing endings json");
+    abort();
+  }
+
+  std::map<int32_t, EndingModel> endings;
+  auto endingIsValid = [](const rapidjson::Value &ending){
+    return ending.HasMember("id") && ending["id"].IsInt() &&
+           ending.HasMember("description") && ending["description"].IsString() &&
+           ending.HasMember("display_name") && ending["display_name"].IsString() &&
+           ending.HasMember("image_tag") && ending["image_tag"].IsString();
+  };
+
+  for (const auto &ending : endingsDocument.GetArray()) {
+    if (!endingIsValid(ending)) {
+      spdlog::warn("Parsing error when adding an ending.");
+      continue;
+    }
+
+    EndingModel model;
+    model.id = ending["id"].GetInt();
+    model.description = ending["description"].GetString();
+    model.display_name = ending["display_name"].GetString();
+    model.image_tag = ending["image_tag"].GetString();
+
+    endings[model.id] = std::move(model);
+  }
+  return endings;
+}
+
+std::map<int32_t, EventModel> parseEvents(const rapidjson::Value &eventDocument,
+                                         std::map<int32_t, std::vector<int32_t>> &eventIdsByMile) {
+  if (!eventDocument.IsArray()) {
+    spdlog::error("Parsing error when parsing events json");
+    abort();
+  }
+
+  std::map<int32_t, EventModel> eventsById;
+  auto event_is_valid = [](const rapidjson::Value &event){
+    return event.HasMember("id") && event["id"].IsInt() &&
+           event.HasMember("actions") && event["actions"].IsArray() &&
+           event.HasMember("description") && event["description"].IsString() &&
+           event.HasMember("display_name") && event["display_name"].IsString() &&
+           event.HasMember("mile") && event["mile"].IsInt();
+  };
+
+  for (const auto &event : eventDocument.GetArray()) {
+    if (!event_is_valid(event)) {
+      spdlog::warn("Parsing error while adding an event");
+      continue;
+    }
+
+    EventModel model;
+    model.id = event["id"].GetInt();
+    model.action_ids = idsFromArray(event["actions"].GetArray());
+    if (event.HasMember("ending_id_hints") && event["ending_id_hints"].IsArray()) {
+      model.ending_id_hints = idsFromArray(event["ending_id_hints"].GetArray());
+    }
+    model.description = event["description"].GetString();
+    model.display_name = event["display_name"].GetString();
+    model.mile = event["mile"].GetInt();
+
+    eventIdsByMile[model.mile].push_back(model.id);
+    eventsById[model.id] = std::move(model);
+  }
+  return eventsById;
+}
+
+std::map<int32_t, IssueModel> parseIssues(const rapidjson::Value &issuesDocument,
+                                          std::unordered_map<IssueModel::Type, std::vector<int32_t>> &issueIdsByType) {
+  if (!issuesDocument.IsArray()) {
+    spdlog::error("Parsing error when parsing issues json");
+    abort();
+  }
+
+  std::map<int32_t, IssueModel> issuesById;
+  auto issueIsValid = [](const rapidjson::Value &value) {
+    return value.HasMember("id") && value["id"].IsInt() &&
+           value.HasMember("actions") && value["actions"].IsArray() &&
+           value.HasMember("description") && value["description"].IsString() &&
+           value.HasMember("display_name") && value["display_name"].IsString() &&
+           value.HasMember("image_url") && value["image_url"].IsString() &&
+           value.HasMember("type") && value["type"].IsString();
+  };
+
+  auto getIssueType = [](const rapidjson::Value &issue) {
+    auto category_str = issue["type"].GetString();
+    if (!strcmp(category_str, "HEALTH")) { return IssueModel::Type::HEALTH; }
+    else if (!strcmp(category_str, "MECHANICAL")) { return IssueModel::Type::MECHANICAL; }
+    else { return IssueModel::Type::INVALID; }
+  };
+
+  for (const auto &issue : issuesDocument.GetArray()) {
+    if (!issueIsValid(issue)) {
+      spdlog::warn("Error parsing issue type");
+      continue;
+    }
+
+    IssueModel model;
+    model.id = issue["id"].GetInt();
+    model.actions = idsFromArray(issue["actions"].GetArray());
+    model.description = issue["description"].GetString();
+    model.display_name = issue["display_name"].GetString();
+    model.image_url = issue["image_url"].GetString();
+    model.type = getIssueType(issue);
+
+    if (issue.HasMember("dependent_actions") && issue["dependent_actions"].IsArray()) {
+      model.dependent_actions = idsFromArray(issue["dependent_actions"].GetArray());
+    }
+
+    if (issue.HasMember("dependent_inventory") && issue["dependent_inventory"].IsArray()) {
+      model.dependent_inventory = idsFromArray(issue["dependent_inventory"].GetArray());
+    }
+
+    if (issue.HasMember("ending_id_hints") && issue["ending_id_hints"].IsArray()) {
+      model.ending_id_hints = idsFromArray(issue["ending_id_hints"].GetArray());
+    }
+
+    if (issue.HasMember("stat_changes") && issue["stat_changes"].IsArray()) {
+      model.stat_delta = Stats::FromJson(issue["stat_changes"].GetArray());
+    }
+
+    issueIdsByType[model.type].push_back(model.id);
+    auto id = model.id;
+    issuesById[id] = std::move(model);
+  }
+  return issuesById;
+}
+
+std::map<int32_t, ItemModel> parseItems(const rapidjson::Value &itemsDocument) {
+  if (!itemsDocument.IsArray()) {
+    spdlog::error("Error parsing items JSON");
+    abort();
+  }
+
+  std::map<int32_t, ItemModel> items;
+  auto get_category = [](const std::string &category){
+    if (category == "BIKE") { return ItemModel::Category::BIKE; }
+    if (category == "MISC") { return ItemModel::Category::MISC; }
+
+    return ItemModel::Category::INVALID;
+  };
+
+  auto item_is_valid = [](const rapidjson::Value &item) {
+    return item.HasMember("id") && item["id"].IsInt() &&
+           item.HasMember("category") && item["category"].IsString() &&
+           item.HasMember("cost") && item["cost"].IsInt() &&
+           item.HasMember("display_name") && item["display_name"].IsString() &&
+           item.HasMember("image_url") && item["image_url"].IsString() &&
+           item.HasMember("stat_changes") && item["stat_changes"].IsArray();
+  };
+
+  for (const auto &item : itemsDocument.GetArray()) {
+    if (!item_is_valid(item)) {
+      spdlog::warn("Unable to parse an item! Skipping it.");
+      continue;
+    }
+
+    ItemModel model;
+    model.id = item["id"].GetInt();
+    model.category = get_category(item["category"].GetString());
+    model.cost = item["cost"].GetInt();
+    model.display_name = item["display_name"].GetString();
+    model.image_url = item["image_url"].GetString();
+    model.stat_delta = Stats::FromJson(item["stat_changes"].GetArray());
+
+    items[model.id] = std::move(model);
+  }
+  return items;
+}
+
+template <typename Model>
+const Model &find(const DenseTable<Model> &models, int32_t id, const Model &empty, const char *kind) {
+  if (auto model = models.find(id)) { return *model; }
+
+  spdlog::warn("Requested {} id {} that does not exist.", kind, id);
+  return empty;
+}
+}
+
+ContentCatalog::ContentCatalog(const ContentPack &pack)
+: m_contentHash(pack.getContentHash()) {
+  m_actions = DenseTable<ActionModel>(parseActions(pack.getActions()));
+  m_endings = DenseTable<EndingModel>(parseEndings(pack.getEndings()));
+  m_eventsById = DenseTable<EventModel>(parseEvents(pack.getEvents(), m_eventIdsByMile));
+  m_issuesById = DenseTable<IssueModel>(parseIssues(pack.getIssues(), m_issueIdsByType));
+  m_items = DenseTable<ItemModel>(parseItems(pack.getItems()));
+  compileIssueDependencies();
+}
+
+void ContentCatalog::compileIssueDependencies() {
+  m_issueIdsByActionIndex.resize(m_actions.size());
+  m_issueIdsByItemIndex.resize(m_items.size());
+
+  m_issueDependencies.reserve(m_issuesById.size());
+  for (const auto &issue : m_issuesById) {
+    IssueDependencies dependencies{Bitset(m_actions.size()), Bitset(m_items.size())};
+    for (auto actionId : issue.dependent_actions) {
+      auto index = m_actions.indexOf(actionId);
+      if (index < 0) {
+        spdlog::warn("Issue {} depends on action {} which doesn't exist", issue.id, actionId);
+        dependencies.satisfiable = false;
+        continue;
+      }
+      dependencies.actions.set(index);
+      m_issueIdsByActionIndex[index].push_back(issue.id);
+    }
+    for (auto itemId : issue.dependent_inventory) {
+      auto index = m_items.indexOf(itemId);
+      if (index < 0) {
+        spdlog::warn("Issue {} depends on item {} which doesn't exist", issue.id, itemId);
+        dependencies.satisfiable = false;
+        continue;
+      }
+      dependencies.items.set(index);
+      m_issueIdsByItemIndex[index].push_back(issue.id);
+    }
+    m_issueDependencies.push_back(std::move(dependencies));
+  }
+}
+
+std::shared_ptr<const ContentCatalog> ContentCatalog::FromPack(const ContentPack &pack) {
+  return std::make_shared<const ContentCatalog>(pack);
+}
+
+std::shared_ptr<const ContentCatalog> ContentCatalog::BuiltIn() {
+  static const auto builtIn = FromPack(*ContentPack::BuiltIn());
+  return builtIn;
+}
+
+const ActionModel &ContentCatalog::getAction(int32_t id) const {
+  return find(m_actions, id, kEmptyActionModel, "action");
+}
+
+const EndingModel &ContentCatalog::getEnding(int32_t id) const {
+  return find(m_endings, id, kEmptyEndingModel, "ending");
+}
+
+const EventModel &ContentCatalog::getEvent(int32_t id) const {
+  return find(m_eventsById, id, kEmptyEventModel, "event");
+}
+
+const IssueModel &ContentCatalog::getIssue(int32_t id) const {
+  return find(m_issuesById, id, kEmptyIssueModel, "issue");
+}
+
+const ItemModel &ContentCatalog::getItem(int32_t id) const {
+  return find(m_items, id, kEmptyItemModel, "item");
+}
+
+const DenseTable<ActionModel> &ContentCatalog::getActions() const { return m_actions; }
+
+const std::map<int32_t, std::vector<int32_t>> &ContentCatalog::getEventIdsByMile() const {
+  return m_eventIdsByMile;
+}
+
+const std::vector<int32_t> &ContentCatalog::getIssueIds(IssueModel::Type type) const {
+  static const std::vector<int32_t> kNoIssues;
+  auto it = m_issueIdsByType.find(type);
+  return it != m_issueIdsByType.end() ? it->second : kNoIssues;
+}
+
+const ContentCatalog::IssueDependencies &ContentCatalog::getIssueDependencies(int32_t issueId) const {
+  static const IssueDependencies kUnknownIssue{Bitset(), Bitset(), false};
+  auto index = m_issuesById.indexOf(issueId);
+  return index < 0 ? kUnknownIssue : m_issueDependencies[index];
+}
+
+int32_t ContentCatalog::getActionIndex(int32_t actionId) const { return m_actions.indexOf(actionId); }
+int32_t ContentCatalog::getItemIndex(int32_t itemId) const { return m_items.indexOf(itemId); }
+size_t ContentCatalog::getItemCount() const { return m_items.size(); }
+
+const std::vector<int32_t> &ContentCatalog::getIssueIdsDependingOnAction(int32_t actionId) const {
+  static const std::vector<int32_t> kNoIssues;
+  auto index = m_actions.indexOf(actionId);
+  return index < 0 ? kNoIssues : m_issueIdsByActionIndex[index];
+}
+
+const std::vector<int32_t> &ContentCatalog::getIssueIdsDependingOnItem(int32_t itemId) const {
+  static const std::vector<int32_t> kNoIssues;
+  auto index = m_items.indexOf(itemId);
+  return index < 0 ? kNoIssues : m_issueIdsByItemIndex[index];
+}
+
+uint64_t ContentCatalog::getContentHash() const { return m_contentHash; }
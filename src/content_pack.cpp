@@ -0,0 +1,163 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/content_pack.hpp>
+
+// System includes
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 3P Includes
+#include <spdlog/spdlog.h>
+
+// Local includes
+#include <libgtfoklahoma/journal.hpp>
+
+// Generated from data/
+#include <builtin_content.hpp>
+
+using namespace libgtfoklahoma;
+
+namespace {
+const char *kFileNames[] = {"actions.json", "endings.json", "events.json", "issues.json", "items.json"};
+}
+
+// ParseInsitu needs a writable, null-terminated buffer. Files are mapped
+// privately so parsing only copies the pages it writes to, never the file.
+struct ContentPack::Source {
+  ~Source() {
+    if (mapping) { munmap(mapping, mappingLength); }
+  }
+
+  bool map(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return false; }
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+      close(fd);
+      return false;
+    }
+    auto size = static_cast<size_t>(info.st_size);
+
+    // Reserve one zeroed byte past the end of the file for the terminator, then map the file over the front of it
+    mappingLength = size + 1;
+    mapping = mmap(nullptr, mappingLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+      mapping = nullptr;
+      close(fd);
+      return false;
+    }
+    if (size && mmap(mapping, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      close(fd);
+      return false;
+    }
+    close(fd);
+    data = static_cast<char *>(mapping);
+    return true;
+  }
+
+  void copy(const char *json) {
+    owned.assign(json, json + strlen(json) + 1);
+    data = owned.data();
+  }
+
+  char *data{nullptr};
+  void *mapping{nullptr};
+  size_t mappingLength{0};
+  std::vector<char> owned;
+  rapidjson::Document document;
+};
+
+ContentPack::ContentPack()
+: m_contentHash(0) {}
+
+ContentPack::~ContentPack() = default;
+
+std::shared_ptr<const ContentPack> ContentPack::LoadDirectory(const std::string &directory) {
+  std::shared_ptr<ContentPack> pack(new ContentPack());
+  for (int i = 0; i < SOURCE_COUNT; i++) {
+    auto path = directory + "/" + kFileNames[i];
+    pack->m_sources[i] = std::make_unique<Source>();
+    if (!pack->m_sources[i]->map(path)) {
+      spdlog::error("Unable to map content file {}", path);
+      return nullptr;
+    }
+  }
+
+  // Hash before parsing, parsing in place rewrites the buffers
+  pack->m_contentHash = HashContent({pack->m_sources[ACTIONS]->data,
+                                     pack->m_sources[ENDINGS]->data,
+                                     pack->m_sources[EVENTS]->data,
+                                     pack->m_sources[ISSUES]->data,
+                                     pack->m_sources[ITEMS]->data});
+
+  for (int i = 0; i < SOURCE_COUNT; i++) {
+    auto &source = *pack->m_sources[i];
+    if (source.document.ParseInsitu(source.data).HasParseError() || !source.document.IsArray()) {
+      spdlog::error("Parsing error in content file {}/{}", directory, kFileNames[i]);
+      return nullptr;
+    }
+  }
+  return pack;
+}
+
+std::shared_ptr<const ContentPack> ContentPack::FromJson(const char *actionJson,
+                                                         const char *endingJson,
+                                                         const char *eventJson,
+                                                         const char *issueJson,
+                                                         const char *itemJson) {
+  std::shared_ptr<ContentPack> pack(new ContentPack());
+  pack->m_contentHash = HashContent({actionJson, endingJson, eventJson, issueJson, itemJson});
+
+  const char *json[SOURCE_COUNT] = {actionJson, endingJson, eventJson, issueJson, itemJson};
+  for (int i = 0; i < SOURCE_COUNT; i++) {
+    pack->m_sources[i] = std::make_unique<Source>();
+    auto &source = *pack->m_sources[i];
+    source.copy(json[i]);
+
+    // Bad content is fatal, same as when the managers parsed strings themselves
+    if (source.document.ParseInsitu(source.data).HasParseError() || !source.document.IsArray()) {
+      spdlog::error("Parsing error when parsing {}", kFileNames[i]);
+      abort();
+    }
+  }
+  return pack;
+}
+
+std::shared_ptr<const ContentPack> ContentPack::BuiltIn() {
+  static const auto builtIn = FromJson(builtin::kActionJson,
+                                       builtin::kEndingJson,
+                                       builtin::kEventJson,
+                                       builtin::kIssueJson,
+                                       builtin::kItemJson);
+  return builtIn;
+}
+
+const rapidjson::Value &ContentPack::getActions() const { return m_sources[ACTIONS]->document; }
+const rapidjson::Value &ContentPack::getEndings() const { return m_sources[ENDINGS]->document; }
+const rapidjson::Value &ContentPack::getEvents() const { return m_sources[EVENTS]->document; }
+const rapidjson::Value &ContentPack::getIssues() const { return m_sources[ISSUES]->document; }
+const rapidjson::Value &ContentPack::getItems() const { return m_sources[ITEMS]->document; }
+
+uint64_t ContentPack::getContentHash() const { return m_contentHash; }
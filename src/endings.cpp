@@ -17,53 +17,17 @@
 
 #include <libgtfoklahoma/endings.hpp>
 
-#include <rapidjson/document.h>
-#include <spdlog/spdlog.h>
-
-#include <libgtfoklahoma/ending_model.hpp>
+#include <libgtfoklahoma/content_catalog.hpp>
 
 using namespace libgtfoklahoma;
 
-Endings::Endings(const char *endingsJson) {
-  rapidjson::Document endingsDocument;
-  if (endingsDocument.Parse(endingsJson).HasParseError() ||
-      !endingsDocument.IsArray()) {
-    spdlog::error("Parsing error when parsing endings json");
-    abort();
-  }
-
-  auto endingIsValid = [](const rapidjson::Value &ending){
-    return ending.HasMember("id") && ending["id"].IsInt() &&
-           ending.HasMember("description") && ending["description"].IsString() &&
-           ending.HasMember("display_name") && ending["display_name"].IsString() &&
-           ending.HasMember("image_tag") && ending["image_tag"].IsString();
-  };
-
-  for (const auto &ending : endingsDocument.GetArray()) {
-    if (!endingIsValid(ending)) {
-      spdlog::warn("Parsing error when adding an ending.");
-      continue;
-    }
-
-    EndingModel model;
-    model.id = ending["id"].GetInt();
-    model.description = ending["description"].GetString();
-    model.display_name = ending["display_name"].GetString();
-    model.image_tag = ending["image_tag"].GetString();
+Endings::Endings(const ContentCatalog &catalog)
+: m_catalog(catalog) {}
 
-    m_endings[model.id] = model;
-  }
-}
-
-EndingModel &Endings::getEnding(int32_t id) {
-  if (m_endings.count(id)) {
-    return m_endings[id];
-  }
-
-  spdlog::warn("Requested ending id {} that does not exist.", id);
-  return kEmptyEndingModel;
+const EndingModel &Endings::getEnding(int32_t id) const {
+  return m_catalog.getEnding(id);
 }
 
 void Endings::handleEnding(int32_t id) {
 
-}
\ No newline at end of file
+}
@@ -18,7 +18,9 @@
 #include <libgtfoklahoma/engine.hpp>
 
 // System includes
+#include <algorithm>
 #include <chrono>
+#include <utility>
 
 // 3P Includes
 #include <spdlog/spdlog.h>
@@ -30,111 +32,378 @@
 
 using namespace libgtfoklahoma;
 
-Engine::Engine(Game &game)
+namespace {
+// Plenty for a player clicking around, small enough to push back on a flood
+const size_t kCommandQueueCapacity = 64;
+}
+
+Engine::Engine(Game &game, std::shared_ptr<IPacingPolicy> pacing, std::shared_ptr<IClock> clock)
 : m_game(game)
-, m_running(false) {}
+, m_pacing(std::move(pacing))
+, m_clock(std::move(clock))
+, m_running(false)
+, m_shouldCheckForEvents(true)
+, m_shouldCheckForHealthIssues(false)
+, m_shouldCheckForMechanicalIssues(false)
+, m_started(false)
+, m_tick(0)
+, m_nextTick(0)
+, m_nextMileTick(0)
+, m_status(Status::RUNNING)
+, m_paused(false)
+, m_milesTravelled(0)
+, m_hoursPassed(0)
+, m_commands(kCommandQueueCapacity) {}
 
 Engine::~Engine() { stop(); }
 
 void Engine::start() {
   spdlog::debug("Starting Engine's event loop");
   m_running = true;
+
+  // Wake up as soon as the player makes a decision the game is waiting on
+  m_game.setInputListener([this]() {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wakeup.notify_all();
+  });
   m_eventLoopThread = std::thread(&Engine::mainLoop, this);
 }
 
 void Engine::stop() {
   spdlog::debug("Stopping Engine's event loop");
-  m_running = false;
-  if (m_eventLoopThread.joinable()) { m_eventLoopThread.join(); }
+  {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_running = false;
+  }
+  m_wakeup.notify_all();
+  if (m_eventLoopThread.joinable()) {
+    m_eventLoopThread.join();
+    m_game.setInputListener(nullptr);
+  }
 }
 
-void Engine::mainLoop() {
-  // Events are checked once per mile
-  bool shouldCheckForEvents = true;
+Engine::Status Engine::advance() {
+  if (m_status == Status::GAME_OVER) { return m_status; }
 
-  // Issues are checked once per hour
-  bool shouldCheckForHealthIssues = false;
-  bool shouldCheckForMechanicalIssues = false;
+  drainCommands();
+  if (m_status == Status::GAME_OVER) {
+    m_game.commitTick();
+    return m_status;
+  }
+  if (m_paused) { return Status::PAUSED; }
 
-  uint32_t tick = 0;
-  int32_t ticksUntilNextMile = rules::TicksUntilNextMile(m_game.getStats().getPlayerStatsModel());
+  if (m_status == Status::AWAITING_INPUT) {
+    // Pick up where we left off, but only once the player has made up their mind
+    if (!m_game.inputIsReady()) { return m_status; }
+    m_status = Status::RUNNING;
 
-  while (m_running) {
-    std::this_thread::sleep_for(rules::kTickDelayMs);
-
-    // Handle queued events ensuring that this is only called once per mile
-    if (shouldCheckForEvents) {
-      for (const auto &observer : m_game.getObservers()) {
-        for (const auto &id : m_game.getQueuedEventIds()) {
-          m_game.getEvents().handleEvent(id, observer);
-        }
-      }
-      shouldCheckForEvents = false;
+    // The tick was committed when we suspended, carry on with a fresh change set
+    m_game.beginTick(m_tick);
+    m_game.resumeIfReady();
+  } else {
+    if (!m_started) {
+      m_nextMileTick = ticksUntilNextMile();
+      m_started = true;
     }
+    m_tick = m_nextTick;
+    m_game.beginTick(m_tick);
+    scheduleTick();
+  }
+
+  while (!m_game.awaitingInput() && !m_pendingWork.empty()) {
+    auto work = std::move(m_pendingWork.front());
+    m_pendingWork.pop_front();
+    work();
+  }
 
-    // Handle any mech issues
-    if (shouldCheckForMechanicalIssues &&
-        m_game.playerIsAwake() &&
-        rules::MechanicalIssueThisHour(m_game.getStats().getPlayerStatsModel())) {
-      auto id = m_game.getIssues().popRandomIssueId(IssueModel::Type::MECHANICAL);
-
-      if (id == -1) {
-        spdlog::debug("No more mechanical issues available!");
-      } else {
-        for (const auto &observer : m_game.getObservers()) {
-          m_game.getIssues().handleIssue(id, observer);
-        }
-      }
+  if (m_game.awaitingInput()) {
+    // Anything done while we wait (eg: shopping) is heard about as it happens
+    // rather than once the player has decided
+    m_game.commitTick();
+    m_status = Status::AWAITING_INPUT;
+    return m_status;
+  }
+
+  m_game.commitTick();
+  if (m_status == Status::GAME_OVER) { return m_status; }
+
+  // Anything that was flagged this tick is handled on the very next one,
+  // otherwise sleep through to the next hour or mile, whichever is sooner.
+  m_nextTick = m_tick + 1;
+  if (!m_shouldCheckForEvents &&
+      !m_shouldCheckForHealthIssues &&
+      !m_shouldCheckForMechanicalIssues) {
+    auto nextHourTick = (m_tick / rules::kTicksPerGameHour + 1) * rules::kTicksPerGameHour;
+    m_nextTick = std::min<uint32_t>(nextHourTick, m_nextMileTick);
+  }
+  return m_status;
+}
+
+Engine::StepResult Engine::advanceTicks(uint32_t ticks) {
+  return runUntil([]() { return false; }, ticks);
+}
+
+Engine::StepResult Engine::runUntil(Until until, uint32_t maxTicks) {
+  const auto miles = m_milesTravelled;
+  const auto hours = m_hoursPassed;
+  switch (until) {
+    case Until::NEXT_MILE:
+      return runUntil([this, miles]() { return m_milesTravelled != miles; }, maxTicks);
+    case Until::NEXT_HOUR:
+      return runUntil([this, hours]() { return m_hoursPassed != hours; }, maxTicks);
+    case Until::BLOCKED:
+      break;
+  }
+  return runUntil([]() { return false; }, maxTicks);
+}
+
+Engine::StepResult Engine::runUntil(const std::function<bool()> &done, uint32_t maxTicks) {
+  StepResult result{StepResult::Reason::TICKS_ELAPSED, getStatus(), 0, m_milesTravelled, m_hoursPassed};
+
+  for (;;) {
+    if (result.status == Status::GAME_OVER) {
+      result.reason = StepResult::Reason::GAME_OVER;
+      break;
     }
-    shouldCheckForMechanicalIssues = false;
-
-    // Handle any health issues
-    if (shouldCheckForHealthIssues && rules::HealthIssueThisHour(m_game.getStats().getPlayerStatsModel())) {
-      auto id = m_game.getIssues().popRandomIssueId(IssueModel::Type::HEALTH);
-
-      if (id == -1) {
-        spdlog::debug("No more health issues available!");
-      } else {
-        for (const auto &observer : m_game.getObservers()) {
-          m_game.getIssues().handleIssue(id, observer);
-        }
-      }
+    if (m_paused && !m_commands.hasPending()) {
+      result.reason = StepResult::Reason::PAUSED;
+      break;
     }
-    shouldCheckForHealthIssues = false;
-
-    // Update the time
-    if (!(tick % rules::kTicksPerGameHour)) {
-      auto new_hour = getNextHour();
-      for (const auto &observer : m_game.getObservers()) {
-        observer->onHourChanged(new_hour);
-      }
-      shouldCheckForHealthIssues = true;
-      shouldCheckForMechanicalIssues = true;
+
+    // Resuming after a decision doesn't cost any time, same as in mainLoop()
+    const auto ticks = ticksUntilNextAdvance();
+    if (ticks > maxTicks - result.ticks) {
+      // Nothing can happen before the next advance, so just move the clock up
+      if (m_started) { m_tick += maxTicks - result.ticks; }
+      result.ticks = maxTicks;
+      result.reason = StepResult::Reason::TICKS_ELAPSED;
+      break;
     }
+    result.ticks += ticks;
 
-    if (!ticksUntilNextMile) {
-      ticksUntilNextMile = rules::TicksUntilNextMile(m_game.getStats().getPlayerStatsModel());
-      auto new_mile = m_game.getCurrentMile() + 1;
-      for (const auto &observer : m_game.getObservers()) {
-        observer->onMileChanged(new_mile);
-      }
-      shouldCheckForEvents = true;
+    result.status = advance();
+    if (result.status == Status::GAME_OVER) {
+      result.reason = StepResult::Reason::GAME_OVER;
+      break;
     }
+    if (result.status == Status::AWAITING_INPUT) {
+      result.reason = StepResult::Reason::AWAITING_INPUT;
+      break;
+    }
+    if (result.status == Status::PAUSED) {
+      // No time goes by while paused, the tick is still to come
+      result.ticks -= ticks;
+      result.reason = StepResult::Reason::PAUSED;
+      break;
+    }
+    if (done()) {
+      result.reason = StepResult::Reason::CONDITION_MET;
+      break;
+    }
+  }
+
+  result.miles = m_milesTravelled - result.miles;
+  result.hours = m_hoursPassed - result.hours;
+  return result;
+}
+
+bool Engine::submit(const Command &command) {
+  if (!m_commands.tryPush(command)) { return false; }
+  m_game.notifyInputListener();
+  return true;
+}
+
+bool Engine::hasPendingCommands() const { return m_commands.hasPending(); }
+
+void Engine::drainCommands() {
+  // Only what's already queued, so a steady stream of commands can't hold up the tick
+  Command command;
+  for (size_t i = 0; i < m_commands.capacity() && m_commands.tryPop(command); i++) {
+    runCommand(command);
+  }
+}
 
-    if (m_game.gameOver()) {
-      // FIXME: ensure ending is poppable and applicable
-      auto ending = m_game.getEndings().getEnding(m_game.popEndingHintId());
-      for (const auto &observer : m_game.getObservers()) {
-        observer->onGameOver(ending);
-      }
+void Engine::runCommand(const Command &command) {
+  bool accepted = true;
+  switch (command.type) {
+    case Command::Type::CHOOSE_EVENT_ACTION:
+      accepted = m_game.getEvents().chooseAction(command.target_id, command.choice_id);
+      break;
+    case Command::Type::CHOOSE_ISSUE_ACTION:
+      accepted = m_game.getIssues().chooseAction(command.target_id, command.choice_id);
+      break;
+    case Command::Type::PURCHASE_ITEM: {
+      // Only from the store the player is in, and only what it stocks. Anything
+      // else couldn't be replayed from the journal either.
+      auto &actions = m_game.getActions();
+      accepted = actions.getAction(command.target_id).itemIsInStock(command.choice_id) &&
+                 m_game.isAwaiting(actions.purchaseComplete(command.target_id)) &&
+                 actions.purchaseItem(command.target_id, command.choice_id);
+      break;
+    }
+    case Command::Type::LEAVE_STORE:
+      m_game.getActions().completePurchase(command.target_id);
+      break;
+    case Command::Type::PAUSE:
+      m_paused = true;
+      break;
+    case Command::Type::RESUME:
+      m_paused = false;
       break;
+    case Command::Type::QUIT:
+      // Walking away isn't an ending, so observers aren't told
+      m_status = Status::GAME_OVER;
+      m_pendingWork.clear();
+      break;
+  }
+
+  if (!accepted) {
+    spdlog::warn("Ignoring command {} for {}, choice {}",
+                 static_cast<int>(command.type), command.target_id, command.choice_id);
+  }
+}
+
+Engine::Status Engine::getStatus() const {
+  return m_paused && m_status != Status::GAME_OVER ? Status::PAUSED : m_status;
+}
+uint32_t Engine::getCurrentTick() const { return m_tick; }
+
+uint32_t Engine::ticksUntilNextAdvance() const {
+  // The very first tick is delayed by one tick, just like every other
+  return m_started ? m_nextTick - m_tick : 1;
+}
+
+const IPacingPolicy &Engine::getPacingPolicy() const { return *m_pacing; }
+const IClock &Engine::getClock() const { return *m_clock; }
+
+void Engine::mainLoop() {
+  // Pace against a deadline rather than sleeping a fixed amount so time spent
+  // processing a tick doesn't slowly drift the game clock.
+  auto deadline = m_clock->now();
+
+  while (m_running) {
+    const auto delay = m_pacing->delayForTicks(ticksUntilNextAdvance());
+
+    // If we fell behind (eg: the player took a minute to pick an action) don't
+    // sprint to catch up, just carry on from now.
+    const auto now = m_clock->now();
+    if (deadline + delay < now) { deadline = now; }
+    deadline += delay;
+    if (delay.count() && !waitUntil(deadline)) { break; }
+
+    auto status = advance();
+
+    // Hold off on the next tick until the player decides what to do
+    while ((status == Status::AWAITING_INPUT || status == Status::PAUSED) && waitForInput()) {
+      status = advance();
     }
 
-    tick++;
-    ticksUntilNextMile--;
+    if (status == Status::GAME_OVER) { break; }
   }
 }
 
+void Engine::scheduleTick() {
+  // Handle queued events ensuring that this is only called once per mile
+  if (m_shouldCheckForEvents) {
+    m_pendingWork.emplace_back([this]() { handleEvents(); });
+    m_shouldCheckForEvents = false;
+  }
+
+  if (m_shouldCheckForMechanicalIssues) {
+    m_pendingWork.emplace_back([this]() { handleIssues(IssueModel::Type::MECHANICAL); });
+    m_shouldCheckForMechanicalIssues = false;
+  }
+
+  if (m_shouldCheckForHealthIssues) {
+    m_pendingWork.emplace_back([this]() { handleIssues(IssueModel::Type::HEALTH); });
+    m_shouldCheckForHealthIssues = false;
+  }
+
+  m_pendingWork.emplace_back([this]() { updateTime(); });
+  m_pendingWork.emplace_back([this]() { updateDistance(); });
+  m_pendingWork.emplace_back([this]() { checkForGameOver(); });
+}
+
+void Engine::handleEvents() {
+  // Each of these may have to wait on the player so queue them up individually
+  std::vector<std::function<void()>> work;
+  for (const auto &observer : m_game.getObservers()) {
+    for (const auto &id : m_game.getQueuedEventIds()) {
+      work.emplace_back([this, id, observer = &observer]() { m_game.getEvents().handleEvent(id, *observer); });
+    }
+  }
+  m_pendingWork.insert(m_pendingWork.begin(), work.begin(), work.end());
+}
+
+void Engine::handleIssues(IssueModel::Type type) {
+  const bool isHealthIssue = type == IssueModel::Type::HEALTH;
+  const auto &stats = m_game.getStats().getPlayerStatsModel();
+
+  if (isHealthIssue && !rules::HealthIssueThisHour(stats, m_game.getIssueRng())) { return; }
+
+  // Mechanical issues only happen while riding
+  if (!isHealthIssue &&
+      !(m_game.playerIsAwake() && rules::MechanicalIssueThisHour(stats, m_game.getIssueRng()))) {
+    return;
+  }
+
+  auto id = m_game.getIssues().popRandomIssueId(type);
+  if (id == -1) {
+    spdlog::debug("No more {} issues available!", isHealthIssue ? "health" : "mechanical");
+    return;
+  }
+
+  std::vector<std::function<void()>> work;
+  for (const auto &observer : m_game.getObservers()) {
+    work.emplace_back([this, id, observer = &observer]() { m_game.getIssues().handleIssue(id, *observer); });
+  }
+  m_pendingWork.insert(m_pendingWork.begin(), work.begin(), work.end());
+}
+
+void Engine::updateTime() {
+  if (m_tick % rules::kTicksPerGameHour) { return; }
+
+  m_hoursPassed++;
+  auto new_hour = getNextHour();
+
+  // Observers see the game as of the new hour
+  m_game.setCurrentHour(new_hour);
+  for (const auto &observer : m_game.getObservers()) {
+    observer->onHourChanged(new_hour);
+  }
+  m_shouldCheckForHealthIssues = true;
+  m_shouldCheckForMechanicalIssues = true;
+}
+
+void Engine::updateDistance() {
+  if (m_tick != m_nextMileTick) { return; }
+
+  m_nextMileTick = m_tick + ticksUntilNextMile();
+  m_milesTravelled++;
+  auto new_mile = m_game.getCurrentMile() + 1;
+  m_game.setCurrentMile(new_mile);
+  for (const auto &observer : m_game.getObservers()) {
+    observer->onMileChanged(new_mile);
+  }
+  m_shouldCheckForEvents = true;
+}
+
+void Engine::checkForGameOver() {
+  if (!m_game.gameOver()) { return; }
+
+  // FIXME: ensure ending is poppable and applicable
+  auto ending = m_game.getEndings().getEnding(m_game.popEndingHintId());
+  m_game.recordGameOver(ending.id);
+
+  // Let observers catch up on the final tick before the game ends
+  m_game.commitTick();
+  for (const auto &observer : m_game.getObservers()) {
+    observer->onGameOver(ending);
+  }
+  m_status = Status::GAME_OVER;
+  m_pendingWork.clear();
+}
+
 void Engine::handleGameOver(int32_t endingId) {
   auto ending = m_game.getEndings().getEnding(endingId);
   ending.score = 100000;
@@ -144,6 +413,28 @@ void Engine::handleGameOver(int32_t endingId) {
   stop();
 }
 
+bool Engine::waitUntil(IClock::TimePoint deadline) {
+  std::unique_lock<std::mutex> lock(m_wakeMutex);
+  m_clock->waitUntil(lock, m_wakeup, deadline, [this]() { return !m_running; });
+  return m_running;
+}
+
+bool Engine::waitForInput() {
+  std::unique_lock<std::mutex> lock(m_wakeMutex);
+  m_wakeup.wait(lock, [this]() {
+    // While paused a decision can't be picked up, so only a command (eg:
+    // RESUME) is worth waking up for
+    return !m_running || m_commands.hasPending() || (!m_paused && m_game.inputIsReady());
+  });
+  return m_running;
+}
+
+uint32_t Engine::ticksUntilNextMile() const {
+  // Really fast riders would otherwise cover a mile in 0 ticks and stall the
+  // scheduler on the same tick forever.
+  return std::max(1, rules::TicksUntilNextMile(m_game.getStats().getPlayerStatsModel()));
+}
+
 int32_t Engine::getNextHour() const {
   return (m_game.getCurrentHour() + 1) % 24;
 }
@@ -0,0 +1,281 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/engine_host.hpp>
+
+// System includes
+#include <algorithm>
+#include <utility>
+
+// 3P Includes
+#include <spdlog/spdlog.h>
+
+// Local includes
+#include <libgtfoklahoma/engine.hpp>
+#include <libgtfoklahoma/game.hpp>
+
+using namespace libgtfoklahoma;
+
+namespace {
+// At real-time pacing one rotation of the wheel covers about 8 seconds
+const size_t kTimerWheelSlots = 512;
+const auto kMinTimerResolution = std::chrono::milliseconds(1);
+}
+
+struct EngineHost::Session {
+  Session(SessionId id, Game &game, std::shared_ptr<IPacingPolicy> pacing, std::shared_ptr<IClock> clock)
+  : id(id)
+  , game(game)
+  , deadline(clock->now())
+  , engine(game, std::move(pacing), std::move(clock))
+  , awaitingInput(false)
+  , removed(false) {}
+
+  SessionId id;
+  Game &game;
+  IClock::TimePoint deadline;
+  Engine engine;
+
+  // Whoever flips this back to false gets to queue the session back up
+  std::atomic<bool> awaitingInput;
+
+  // Held while anything touches the game so it can be safely removed
+  std::mutex mutex;
+  bool removed;
+};
+
+EngineHost::EngineHost(uint32_t workerCount,
+                       std::shared_ptr<IPacingPolicy> pacing,
+                       std::shared_ptr<IClock> clock)
+: m_pacing(std::move(pacing))
+, m_clock(std::move(clock))
+, m_running(true)
+, m_nextSessionId(0)
+, m_timerWheel(std::max<std::chrono::nanoseconds>(m_pacing->delayForTicks(1), kMinTimerResolution),
+               kTimerWheelSlots,
+               m_clock->now()) {
+  workerCount = std::max(1u, workerCount);
+  spdlog::debug("Starting engine host with {} workers", workerCount);
+  for (uint32_t i = 0; i < workerCount; i++) {
+    m_workers.emplace_back(&EngineHost::workerLoop, this);
+  }
+  m_timerThread = std::thread(&EngineHost::timerLoop, this);
+}
+
+EngineHost::~EngineHost() { stop(); }
+
+EngineHost::SessionId EngineHost::addSession(Game &game) {
+  SessionPtr session;
+  {
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    auto id = m_nextSessionId++;
+    session = std::make_shared<Session>(id, game, m_pacing, m_clock);
+    m_sessions[id] = session;
+  }
+
+  std::weak_ptr<Session> weakSession = session;
+  game.setInputListener([this, weakSession]() {
+    if (auto session = weakSession.lock()) { resumeSession(session); }
+  });
+  scheduleNextTick(session);
+  return session->id;
+}
+
+void EngineHost::removeSession(SessionId id) {
+  SessionPtr session;
+  {
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    auto it = m_sessions.find(id);
+    if (it == m_sessions.end()) { return; }
+    session = std::move(it->second);
+    m_sessions.erase(it);
+  }
+
+  // Waits out a worker that is in the middle of advancing this session.
+  // Wherever the session is queued it gets dropped the next time it comes up.
+  std::lock_guard<std::mutex> lock(session->mutex);
+  session->game.setInputListener(nullptr);
+  session->removed = true;
+}
+
+bool EngineHost::submit(SessionId id, const Command &command) {
+  SessionPtr session;
+  {
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    auto it = m_sessions.find(id);
+    if (it == m_sessions.end()) { return false; }
+    session = it->second;
+  }
+
+  // Lock-free, and wakes the session through its input listener if it's parked
+  return session->engine.submit(command);
+}
+
+bool EngineHost::hasSession(SessionId id) const {
+  std::lock_guard<std::mutex> lock(m_sessionsMutex);
+  return m_sessions.count(id);
+}
+
+size_t EngineHost::sessionCount() const {
+  std::lock_guard<std::mutex> lock(m_sessionsMutex);
+  return m_sessions.size();
+}
+
+void EngineHost::stop() {
+  if (!m_running.exchange(false)) { return; }
+  spdlog::debug("Stopping engine host");
+
+  // Players can still make decisions after the host is gone
+  {
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    for (auto &idSessionPair : m_sessions) {
+      auto &session = idSessionPair.second;
+      std::lock_guard<std::mutex> sessionLock(session->mutex);
+      session->game.setInputListener(nullptr);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_runQueueMutex);
+    m_runQueueChanged.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_timerMutex);
+    m_timerChanged.notify_all();
+  }
+
+  for (auto &worker : m_workers) {
+    if (worker.joinable()) { worker.join(); }
+  }
+  if (m_timerThread.joinable()) { m_timerThread.join(); }
+}
+
+void EngineHost::runSession(const SessionPtr &session) {
+  Engine::Status status;
+  bool inputIsReady = false;
+  {
+    std::lock_guard<std::mutex> lock(session->mutex);
+    if (session->removed) { return; }
+    status = session->engine.advance();
+
+    // Leave the session be until the player decides or sends a command. If
+    // they beat us to it their wake up may have been missed, so check again
+    // once we're listening.
+    if (status == Engine::Status::AWAITING_INPUT || status == Engine::Status::PAUSED) {
+      session->awaitingInput = true;
+      // A decision made while paused can't be picked up until RESUME comes in
+      inputIsReady = session->engine.hasPendingCommands() ||
+                     (status != Engine::Status::PAUSED && session->game.inputIsReady());
+    }
+  }
+
+  switch (status) {
+    case Engine::Status::GAME_OVER:
+      finishSession(session);
+      break;
+    case Engine::Status::AWAITING_INPUT:
+    case Engine::Status::PAUSED:
+      if (inputIsReady) { resumeSession(session); }
+      break;
+    case Engine::Status::RUNNING:
+      scheduleNextTick(session);
+      break;
+  }
+}
+
+void EngineHost::resumeSession(const SessionPtr &session) {
+  bool expected = true;
+  if (session->awaitingInput.compare_exchange_strong(expected, false)) {
+    enqueue(session);
+  }
+}
+
+void EngineHost::scheduleNextTick(const SessionPtr &session) {
+  const auto delay = m_pacing->delayForTicks(session->engine.ticksUntilNextAdvance());
+
+  // Same as the engine's own loop, don't sprint to catch up after a stall
+  const auto now = m_clock->now();
+  if (session->deadline + delay < now) { session->deadline = now; }
+  session->deadline += delay;
+
+  if (!delay.count()) {
+    enqueue(session);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_timerMutex);
+  const bool wasIdle = !m_timerWheel.size();
+  const auto previousExpiry = wasIdle ? IClock::TimePoint::max() : m_timerWheel.nextExpiry();
+  m_timerWheel.schedule(session->deadline, session);
+
+  // The timer thread stops watching the clock while it has nothing to wait
+  // on, and otherwise sleeps until whatever was due first
+  if (m_timerWheel.nextExpiry() < previousExpiry) { m_timerChanged.notify_one(); }
+}
+
+void EngineHost::finishSession(const SessionPtr &session) {
+  std::lock_guard<std::mutex> lock(m_sessionsMutex);
+  m_sessions.erase(session->id);
+}
+
+void EngineHost::enqueue(SessionPtr session) {
+  {
+    std::lock_guard<std::mutex> lock(m_runQueueMutex);
+    m_runQueue.push_back(std::move(session));
+  }
+  m_runQueueChanged.notify_one();
+}
+
+void EngineHost::timerLoop() {
+  std::unique_lock<std::mutex> lock(m_timerMutex);
+  while (m_running) {
+    if (!m_timerWheel.size()) {
+      m_timerChanged.wait(lock, [this]() { return !m_running || m_timerWheel.size(); });
+      continue;
+    }
+    // Something due sooner may be scheduled while we wait
+    const auto expiry = m_timerWheel.nextExpiry();
+    m_clock->waitUntil(lock, m_timerChanged, expiry, [this, expiry]() {
+      return !m_running || m_timerWheel.nextExpiry() < expiry;
+    });
+    if (!m_running) { break; }
+
+    std::vector<SessionPtr> due;
+    m_timerWheel.advance(m_clock->now(), due);
+
+    // Don't hold up the workers scheduling their sessions while queueing these
+    lock.unlock();
+    for (auto &session : due) {
+      enqueue(std::move(session));
+    }
+    lock.lock();
+  }
+}
+
+void EngineHost::workerLoop() {
+  for (;;) {
+    SessionPtr session;
+    {
+      std::unique_lock<std::mutex> lock(m_runQueueMutex);
+      m_runQueueChanged.wait(lock, [this]() { return !m_running || !m_runQueue.empty(); });
+      if (!m_running) { return; }
+      session = std::move(m_runQueue.front());
+      m_runQueue.pop_front();
+    }
+    runSession(session);
+  }
+}
@@ -19,24 +19,8 @@
 
 #include <algorithm>
 
-#include <spdlog/spdlog.h>
-
 using namespace libgtfoklahoma;
 
-bool EventModel::chooseAction(int32_t actionId) {
-  if (actionIdIsValid(actionId)) {
-    m_chosenAction.set_value(actionId);
-    return true;
-  }
-
-  spdlog::warn("{} is an invalid action id for this event!", actionId);
-  return false;
-}
-
-std::future<int32_t> EventModel::chosenAction() {
-  return m_chosenAction.get_future();
-}
-
 bool EventModel::actionIdIsValid(int32_t actionId) const {
   auto it = std::find(action_ids.cbegin(), action_ids.cend(), actionId);
   return it != action_ids.cend();
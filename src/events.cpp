@@ -17,95 +17,70 @@
 
 #include <libgtfoklahoma/events.hpp>
 
-#include <rapidjson/document.h>
 #include <spdlog/spdlog.h>
 
 #include <libgtfoklahoma/actions.hpp>
+#include <libgtfoklahoma/content_catalog.hpp>
 #include <libgtfoklahoma/event_observer.hpp>
 #include <libgtfoklahoma/game.hpp>
 
 using namespace libgtfoklahoma;
-using namespace rapidjson;
 
-Events::Events(Game &game, const char *eventJson)
-: m_game(game) {
-  rapidjson::Document eventDocument;
-  if (eventDocument.Parse(eventJson).HasParseError() ||
-      !eventDocument.IsArray()) {
-    spdlog::error("Parsing error when parsing events json");
-    abort();
-  }
-
-  auto event_is_valid = [](const rapidjson::Value &event){
-    return event.HasMember("id") && event["id"].IsInt() &&
-           event.HasMember("actions") && event["actions"].IsArray() &&
-           event.HasMember("description") && event["description"].IsString() &&
-           event.HasMember("display_name") && event["display_name"].IsString() &&
-           event.HasMember("mile") && event["mile"].IsInt();
-  };
-
-  auto idsFromArray = [](const rapidjson::GenericArray<true, rapidjson::Value> &arr) {
-    std::vector<int32_t> result;
-    for (const auto &id : arr) {
-      result.emplace_back(id.GetInt());
-    }
-    return result;
-  };
-
-  for (const auto &event : eventDocument.GetArray()) {
-    if (!event_is_valid(event)) {
-      spdlog::warn("Parsing error while adding an event");
-      continue;
-    }
-
-    EventModel model;
-    model.id = event["id"].GetInt();
-    model.action_ids = idsFromArray(event["actions"].GetArray());
-    if (event.HasMember("ending_id_hints") && event["ending_id_hints"].IsArray()) {
-      for (const auto &endingId : event["ending_id_hints"].GetArray()) {
-        model.ending_id_hints.emplace_back(endingId.GetInt());
-      }
-    }
-    model.description = event["description"].GetString();
-    model.display_name = event["display_name"].GetString();
-    model.mile = event["mile"].GetInt();
+Events::Events(Game &game, const ContentCatalog &catalog)
+: m_game(game)
+, m_catalog(catalog) {}
 
-    m_eventsByMile[model.mile].push_back(model.id);
-    m_eventsById[model.id] = std::move(model);
-  }
+const EventModel &Events::getEvent(int32_t id) const {
+  return m_catalog.getEvent(id);
 }
 
-EventModel &Events::getEvent(int32_t id) {
-  if (m_eventsById.count(id)) {
-    return m_eventsById.at(id);
-  }
-
-  spdlog::warn("Requested event id {} that does not exist.", id);
-  return kEmptyEventModel;
-}
-
-void Events::handleEvent(int32_t id, const std::shared_ptr<IEventObserver> &observer) {
+void Events::handleEvent(int32_t id,
+                         const std::shared_ptr<IEventObserver> &observer,
+                         std::function<void()> then) {
   auto &event = getEvent(id);
+  auto &decision = m_chosenActions.ask(id);
   bool shouldHandle = observer && observer->onEvent(event);
-  if (!shouldHandle) { return; }
+  if (!shouldHandle) {
+    // Replays need to know to let it go by as well
+    if (observer) { m_game.recordInput({JournalEntry::Type::EVENT_DECLINED, id}); }
+    if (then) { then(); }
+    return;
+  }
 
   // If this event causes the game to end, hint to the engine which ending to use
   for (const auto &endingId : event.ending_id_hints) {
     m_game.pushEndingHintId(endingId);
   }
 
-  auto actionId = event.chosenAction().get();
-  auto &actions = m_game.getActions();
-  actions.handleAction(actionId, observer);
+  m_game.awaitInput(decision, [this, id, &decision, observer, then]() {
+    m_game.recordInput({JournalEntry::Type::EVENT_ACTION, id, decision.get()});
+    m_game.getActions().handleAction(decision.get(), observer, then);
+  });
+}
+
+bool Events::chooseAction(int32_t eventId, int32_t actionId) {
+  if (getEvent(eventId).actionIdIsValid(actionId)) {
+    return chosenAction(eventId).decide(actionId);
+  }
+
+  spdlog::warn("{} is an invalid action id for this event!", actionId);
+  return false;
+}
+
+Decision<int32_t> &Events::chosenAction(int32_t eventId) {
+  return m_chosenActions.get(eventId);
 }
 
 std::vector<int32_t> Events::eventsAtMile(int32_t mile) const {
-  if (m_eventsByMile.count(mile))
-    return m_eventsByMile.at(mile);
+  const auto &eventsByMile = m_catalog.getEventIdsByMile();
+  auto it = eventsByMile.find(mile);
+  if (it != eventsByMile.end())
+    return it->second;
   else
     return {};
 }
 
 bool Events::hasMoreEvents(int32_t mile) const {
-  return m_eventsByMile.upper_bound(mile) != m_eventsByMile.end();
+  const auto &eventsByMile = m_catalog.getEventIdsByMile();
+  return eventsByMile.upper_bound(mile) != eventsByMile.end();
 }
@@ -17,64 +17,46 @@
 
 #include <libgtfoklahoma/game.hpp>
 
+#include <algorithm>
+#include <utility>
+
 #include <spdlog/spdlog.h>
 
 #include <libgtfoklahoma/stat_model.hpp>
 
 using namespace libgtfoklahoma;
 
-// We need our own observer to keep track of certain changes
-class InternalObserver : public IEventObserver {
-public:
-    explicit InternalObserver(Game &game)
-    : IEventObserver(game) {}
-
-    void onGameOver(const EndingModel&) override {}
-    void onHourChanged(int32_t hour) override { m_game.setCurrentHour(hour); }
-    void onMileChanged(int32_t mile) override { m_game.setCurrentMile(mile); }
-    bool onEvent(EventModel&) override { return false; }
-    bool onIssueOccurred(IssueModel&) override { return false; }
-    void onStatsChanged(const StatModel&) override {}
-    bool onStoreEntered(ActionModel&) override { return false; }
-};
-
-Game::Game(std::string name)
-: m_actions(Actions(*this))
-, m_currentHour(0)
-, m_currentMile(0)
-, m_endings(Endings())
-, m_events(Events(*this))
-, m_issues(Issues(*this))
-, m_items(Items())
-, m_name(std::move(name))
-, m_stats(Stats(
-          *this,
-          StatModel(
-              rules::kDefaultBedtimeHour,
-              rules::kDefaultHealth,
-              0,
-              1,
-              rules::kDefaultMoneyRemaining,
-              rules::kDefaultOddsHealthIssuePerHour,
-              rules::kDefaultOddsMechanicalIssuePerHour,
-              StatModel::Pace::FRED,
-              rules::kDefaultWakeupHour))) {
-  m_observers.emplace_back(std::make_unique<InternalObserver>(*this));
+namespace {
+enum RngStream : uint64_t { kActionStream, kIssueStream };
 }
 
+Game::Game(std::string name, uint64_t seed)
+: Game(std::move(name), ContentCatalog::BuiltIn(), seed) {}
+
 Game::Game(std::string name,
            const char *actionJson,
            const char *endingJson,
            const char *eventJson,
            const char *issueJson,
-           const char *itemJson)
-: m_actions(Actions(*this, actionJson))
+           const char *itemJson,
+           uint64_t seed)
+: Game(std::move(name),
+       ContentCatalog::FromPack(*ContentPack::FromJson(actionJson, endingJson, eventJson, issueJson, itemJson)),
+       seed) {}
+
+Game::Game(std::string name, std::shared_ptr<const ContentCatalog> catalog, uint64_t seed)
+: m_catalog(std::move(catalog))
+, m_seed(seed)
+, m_actionRng(seed, kActionStream)
+, m_issueRng(seed, kIssueStream)
+, m_actions(Actions(*this, *m_catalog))
 , m_currentHour(0)
 , m_currentMile(0)
-, m_endings(Endings(endingJson))
-, m_events(Events(*this, eventJson))
-, m_issues(Issues(*this, issueJson))
-, m_items(Items(itemJson))
+, m_endings(Endings(*m_catalog))
+, m_events(Events(*this, *m_catalog))
+, m_pendingInput(nullptr)
+, m_issues(Issues(*this, *m_catalog))
+, m_items(Items(*m_catalog))
 , m_name(std::move(name))
 , m_stats(Stats(
           *this,
@@ -88,7 +70,7 @@ Game::Game(std::string name,
                rules::kDefaultOddsMechanicalIssuePerHour,
          StatModel::Pace::FRED,
                rules::kDefaultWakeupHour))) {
-  m_observers.emplace_back(std::make_unique<InternalObserver>(*this));
+  publishPlayerState();
 }
 
 /** Access game components */
@@ -98,9 +80,15 @@ Issues &Game::getIssues() { return m_issues; }
 Items &Game::getItems() { return m_items; }
 Stats &Game::getStats() { return m_stats; }
 
+/** Content management */
+const std::shared_ptr<const ContentCatalog> &Game::getCatalog() const { return m_catalog; }
+
 /** Distance management */
 int32_t Game::getCurrentMile() const { return m_currentMile; }
-void Game::setCurrentMile(const int32_t mile) { m_currentMile = mile; }
+void Game::setCurrentMile(const int32_t mile) {
+  m_currentMile = mile;
+  publishPlayerState();
+}
 
 /** Ending management */
 bool Game::gameOver() {
@@ -126,60 +114,181 @@ void Game::pushEndingHintId(int32_t endingId) {
   m_endingHints.push(endingId);
 }
 
+std::vector<int32_t> Game::getEndingHintIds() const {
+  std::vector<int32_t> result;
+  for (auto hints = m_endingHints; !hints.empty(); hints.pop()) {
+    result.push_back(hints.top());
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+void Game::setEndingHintIds(const std::vector<int32_t> &endingIds) {
+  m_endingHints = {};
+  for (auto id : endingIds) {
+    m_endingHints.push(id);
+  }
+}
+
 /** Event management */
 std::vector<int32_t> Game::getQueuedEventIds() const {
  return m_events.eventsAtMile(m_currentMile);
 }
 
+/** Input management */
+void Game::awaitInput(IDecision &decision, std::function<void()> resume) {
+  if (awaitingInput()) {
+    spdlog::error("Already waiting on the player, dropping the new request!");
+    return;
+  }
+
+  // Most of the time the player has already decided by the time we ask
+  if (decision.isDecided()) {
+    resume();
+    return;
+  }
+
+  m_pendingInput = &decision;
+  m_resumeOnInput = std::move(resume);
+  decision.onDecided([this]() { notifyInputListener(); });
+}
+
+bool Game::awaitingInput() const { return m_pendingInput; }
+
+bool Game::isAwaiting(const IDecision &decision) const {
+  return m_pendingInput == &decision && !decision.isDecided();
+}
+
+bool Game::inputIsReady() const {
+  return m_pendingInput && m_pendingInput->isDecided();
+}
+
+bool Game::resumeIfReady() {
+  if (!inputIsReady()) { return false; }
+
+  // Resuming may well wait on the player again, so clear this one out first
+  auto resume = std::move(m_resumeOnInput);
+  m_pendingInput = nullptr;
+  m_resumeOnInput = nullptr;
+  resume();
+  return true;
+}
+
+void Game::setInputListener(std::function<void()> listener) {
+  std::lock_guard<std::mutex> lock(m_inputListenerMutex);
+  m_inputListener = std::move(listener);
+}
+
+void Game::notifyInputListener() {
+  std::lock_guard<std::mutex> lock(m_inputListenerMutex);
+  if (m_inputListener) { m_inputListener(); }
+}
+
 /** Inventory management */
 void Game::addItemToInventory(int32_t id, int32_t quantity) {
-  auto item = getItems().getItem(id);
-  for (int i = 0; i < quantity; i ++) {
-    updateStats(item.stat_delta);
+  // The inventory ignores these, so the stats have to as well
+  if (quantity <= 0) { return; }
+  updateStats(getItems().getItem(id).stat_delta * quantity);
+  storeItem(id, quantity);
+}
+
+void Game::addItemsToInventory(const std::map<int32_t, int32_t> &quantities) {
+  // Everything but max_mph defaults to 0
+  StatModel delta(0, 0, 0, 0);
+  bool added = false;
+  for (const auto &idQuantityPair : quantities) {
+    if (idQuantityPair.second <= 0) { continue; }
+    delta += getItems().getItem(idQuantityPair.first).stat_delta * idQuantityPair.second;
+    storeItem(idQuantityPair.first, idQuantityPair.second);
+    added = true;
   }
+  if (added) { updateStats(delta); }
+}
 
-  if (m_inventory.count(id)) {
-    m_inventory[id] += quantity;
-  } else {
-    m_inventory[id] = quantity;
+void Game::removeItemsFromInventory(const std::map<int32_t, int32_t> &quantities) {
+  for (const auto &idQuantityPair : quantities) {
+    removeItemFromInventory(idQuantityPair.first, idQuantityPair.second);
   }
 }
 
+void Game::storeItem(int32_t id, int32_t quantity) {
+  m_inventory.add(id, quantity);
+  m_issues.inventoryChanged(id);
+  m_unsavedChanges.inventory_ids.insert(id);
+  recordInventoryChange(id, quantity);
+}
+
 void Game::removeItemFromInventory(int32_t id, int32_t quantity) {
-  if (!m_inventory.count(id)) {
+  const auto removed = m_inventory.remove(id, quantity);
+  if (!removed) {
     spdlog::warn("Trying to remove an item that you don't have!");
     return;
   }
-
-  if (m_inventory[id] <= quantity) {
-    m_inventory.erase(id);
-  } else {
-    m_inventory[id] -= quantity;
-  }
+  m_issues.inventoryChanged(id);
+  m_unsavedChanges.inventory_ids.insert(id);
+  recordInventoryChange(id, -removed);
 }
 
 int32_t Game::inventoryCount(int32_t id) const {
   return m_inventory.count(id);
 }
 
-std::vector<std::reference_wrapper<ItemModel>> Game::getInventory() {
-  std::vector<std::reference_wrapper<ItemModel>> result;
-  for (const auto &item : m_inventory) {
-    for (int i = 0; i < item.second; i++) {
-      result.emplace_back(m_items.getItem(item.first));
-    }
+InventoryView Game::getInventory() const { return InventoryView(m_inventory, m_items); }
+
+const Inventory &Game::getInventoryCounts() const { return m_inventory; }
+
+void Game::setInventoryCounts(Inventory inventory) {
+  for (const auto &[id, quantity] : m_inventory) {
+    m_unsavedChanges.inventory_ids.insert(id);
   }
-  return result;
+  m_inventory = std::move(inventory);
+  for (const auto &[id, quantity] : m_inventory) {
+    m_unsavedChanges.inventory_ids.insert(id);
+  }
+  m_issues.inventoryChanged();
+}
+
+/** Journal management */
+void Game::recordTo(std::shared_ptr<Journal> journal) {
+  if (journal) { *journal = Journal(m_seed, getContentHash()); }
+  m_journal = std::move(journal);
+}
+
+uint64_t Game::getContentHash() const { return m_catalog->getContentHash(); }
+
+void Game::recordInput(JournalEntry entry) {
+  if (m_journal) { m_journal->append(entry); }
+}
+
+void Game::recordGameOver(int32_t endingId) {
+  if (!m_journal) { return; }
+  JournalOutcome outcome;
+  outcome.ending_id = endingId;
+  outcome.hour = m_currentHour;
+  outcome.mile = m_currentMile;
+  outcome.stats = m_stats.getPlayerStatsModel();
+  m_journal->setOutcome(outcome);
 }
 
 /** Observer management */
-std::vector<std::shared_ptr<IEventObserver>>
-Game::getObservers() {
-  return m_observers;
+const ObserverRegistry::List &Game::getObservers() const {
+  return m_observers.get();
 }
 
 void Game::registerEventObserver(std::shared_ptr<IEventObserver> observer) {
-  m_observers.emplace_back(std::move(observer));
+  m_observers.add(std::move(observer));
+}
+
+/** Random numbers */
+uint64_t Game::getSeed() const { return m_seed; }
+Rng &Game::getActionRng() { return m_actionRng; }
+Rng &Game::getIssueRng() { return m_issueRng; }
+
+/** Save management */
+Game::Changes &Game::getUnsavedChanges() { return m_unsavedChanges; }
+
+Game::Changes Game::takeUnsavedChanges() {
+  return std::exchange(m_unsavedChanges, {});
 }
 
 /** Stats management */
@@ -189,13 +298,69 @@ bool Game::playerIsAwake() const {
 }
 
 void Game::updateStats(const StatModel &delta) {
-  StatModel cpy(m_stats.getPlayerStatsModel());
-  m_stats.setPlayerStatsModel(cpy + delta);
-  for (const auto &observer : m_observers) {
+  m_stats.setPlayerStatsModel(m_stats.getPlayerStatsModel() + delta);
+
+  // Held until the tick is committed
+  if (m_openTick) { return; }
+  for (const auto &observer : m_observers.get()) {
     observer->onStatsChanged(m_stats.getPlayerStatsModel());
   }
 }
 
 /** Time management */
 int32_t Game::getCurrentHour() const { return m_currentHour; }
-void Game::setCurrentHour(int32_t hour) { m_currentHour = hour; }
+void Game::setCurrentHour(int32_t hour) {
+  m_currentHour = hour;
+  publishPlayerState();
+}
+
+/** Tick management */
+void Game::beginTick(uint32_t tick) {
+  if (m_openTick) { return; }
+  m_openTick.emplace();
+  m_openTick->tick = tick;
+  m_openTick->stats_before = m_stats.getPlayerStatsModel();
+  m_openTick->mile_before = m_currentMile;
+  m_openTick->hour_before = m_currentHour;
+}
+
+void Game::commitTick() {
+  if (!m_openTick) { return; }
+  auto changes = std::move(*m_openTick);
+  m_openTick.reset();
+
+  changes.stats_after = m_stats.getPlayerStatsModel();
+  changes.mile_after = m_currentMile;
+  changes.hour_after = m_currentHour;
+
+  const auto &observers = m_observers.get();
+  if (changes.statsChanged()) {
+    for (const auto &observer : observers) {
+      observer->onStatsChanged(changes.stats_after);
+    }
+  }
+  for (const auto &observer : observers) {
+    observer->onTickCommitted(changes);
+  }
+}
+
+void Game::flushTick() {
+  if (!m_openTick) { return; }
+  const auto tick = m_openTick->tick;
+  commitTick();
+  beginTick(tick);
+}
+
+void Game::recordInventoryChange(int32_t id, int32_t quantity) {
+  if (!m_openTick || !quantity) { return; }
+  auto &delta = m_openTick->inventory_delta[id];
+  delta += quantity;
+  if (!delta) { m_openTick->inventory_delta.erase(id); }
+}
+
+/** State management */
+Game::PlayerState Game::getPlayerState() const { return m_playerState.load(); }
+
+void Game::publishPlayerState() {
+  m_playerState.store(PlayerState{m_stats.getPlayerStatsModel(), m_currentMile, m_currentHour});
+}
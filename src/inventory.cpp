@@ -0,0 +1,86 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/inventory.hpp>
+
+#include <algorithm>
+
+#include <libgtfoklahoma/items.hpp>
+
+using namespace libgtfoklahoma;
+
+namespace {
+bool idIsLess(const Inventory::Entry &entry, int32_t id) { return entry.id < id; }
+}
+
+int32_t Inventory::count(int32_t id) const {
+  auto entry = find(id);
+  return entry ? entry->quantity : 0;
+}
+
+const Inventory::Entry *Inventory::find(int32_t id) const {
+  auto it = lowerBound(id);
+  return it != m_entries.end() && it->id == id ? &*it : nullptr;
+}
+
+void Inventory::add(int32_t id, int32_t quantity) {
+  if (quantity <= 0) { return; }
+
+  // Restores and loadouts come in id order, so this is usually an append
+  if (m_entries.empty() || m_entries.back().id < id) {
+    m_entries.push_back({id, quantity});
+    return;
+  }
+
+  auto it = lowerBound(id);
+  if (it != m_entries.end() && it->id == id) {
+    it->quantity += quantity;
+  } else {
+    m_entries.insert(it, {id, quantity});
+  }
+}
+
+int32_t Inventory::remove(int32_t id, int32_t quantity) {
+  auto it = lowerBound(id);
+  if (it == m_entries.end() || it->id != id) { return 0; }
+
+  if (it->quantity <= quantity) {
+    const auto removed = it->quantity;
+    m_entries.erase(it);
+    return removed;
+  }
+  it->quantity -= quantity;
+  return quantity;
+}
+
+void Inventory::clear() { m_entries.clear(); }
+
+std::vector<Inventory::Entry>::iterator Inventory::lowerBound(int32_t id) {
+  return std::lower_bound(m_entries.begin(), m_entries.end(), id, idIsLess);
+}
+
+Inventory::const_iterator Inventory::lowerBound(int32_t id) const {
+  return std::lower_bound(m_entries.begin(), m_entries.end(), id, idIsLess);
+}
+
+InventoryView::Entry InventoryView::Iterator::operator*() const {
+  return {m_items->getItem(m_it->id), m_it->quantity};
+}
+
+InventoryView::InventoryView(const Inventory &inventory, const Items &items)
+: m_inventory(inventory)
+, m_items(items) {}
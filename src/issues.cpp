@@ -17,110 +17,45 @@
 
 #include <libgtfoklahoma/issues.hpp>
 
-#include <algorithm>
-#include <iterator>
-#include <random>
-
-#include <rapidjson/document.h>
 #include <spdlog/spdlog.h>
 
+#include <libgtfoklahoma/content_catalog.hpp>
 #include <libgtfoklahoma/event_observer.hpp>
 #include <libgtfoklahoma/game.hpp>
 
 using namespace libgtfoklahoma;
 
-
-Issues::Issues(Game &game, const char *issuesJson)
-: m_game(game) {
-
-  rapidjson::Document issuesDocument;
-  if (issuesDocument.Parse(issuesJson).HasParseError() ||
-      !issuesDocument.IsArray()) {
-    spdlog::error("Parsing error when parsing issues json");
-    abort();
-  }
-
-  auto issueIsValid = [](const rapidjson::Value &value) {
-    return value.HasMember("id") && value["id"].IsInt() &&
-           value.HasMember("actions") && value["actions"].IsArray() &&
-           value.HasMember("description") && value["description"].IsString() &&
-           value.HasMember("display_name") && value["display_name"].IsString() &&
-           value.HasMember("image_url") && value["image_url"].IsString() &&
-           value.HasMember("type") && value["type"].IsString();
-  };
-
-  auto getIssueType = [](const rapidjson::Value &issue) {
-    auto category_str = issue["type"].GetString();
-    if (!strcmp(category_str, "HEALTH")) { return IssueModel::Type::HEALTH; }
-    else if (!strcmp(category_str, "MECHANICAL")) { return IssueModel::Type::MECHANICAL; }
-    else { return IssueModel::Type::INVALID; }
-  };
-
-  auto idsFromArray = [](const rapidjson::GenericArray<true, rapidjson::Value> &arr) {
-    std::vector<int32_t> result;
-    for (const auto &id : arr) {
-      result.emplace_back(id.GetInt());
-    }
-    return result;
-  };
-
-  for (const auto &issue : issuesDocument.GetArray()) {
-    if (!issueIsValid(issue)) {
-      spdlog::warn("Error parsing issue type");
-      continue;
-    }
-
-    IssueModel model;
-    model.id = issue["id"].GetInt();
-    for (const auto &actionId : issue["actions"].GetArray()) {
-      model.actions.emplace_back(actionId.GetInt());
+Issues::Issues(Game &game, const ContentCatalog &catalog)
+: m_game(game)
+, m_catalog(catalog)
+, m_happenedActions(catalog.getActions().size())
+, m_ownedItems(catalog.getItemCount())
+, m_eligibleHealthIssues(catalog.getIssueIds(IssueModel::Type::HEALTH).size())
+, m_eligibleMechanicalIssues(catalog.getIssueIds(IssueModel::Type::MECHANICAL).size()) {
+  for (auto type : {IssueModel::Type::HEALTH, IssueModel::Type::MECHANICAL}) {
+    const auto &ids = m_catalog.getIssueIds(type);
+    for (size_t i = 0; i < ids.size(); ++i) {
+      m_issuePositions[ids[i]] = i;
     }
-    model.description = issue["description"].GetString();
-    model.display_name = issue["display_name"].GetString();
-    model.image_url = issue["image_url"].GetString();
-    model.type = getIssueType(issue);
-
-    if (issue.HasMember("dependent_actions") && issue["dependent_actions"].IsArray()) {
-      model.dependent_actions = idsFromArray(issue["dependent_actions"].GetArray());
-    }
-
-    if (issue.HasMember("dependent_inventory") && issue["dependent_inventory"].IsArray()) {
-      model.dependent_inventory = idsFromArray(issue["dependent_inventory"].GetArray());
-    }
-
-    if (issue.HasMember("ending_id_hints") && issue["ending_id_hints"].IsArray()) {
-      for (const auto &endingId : issue["ending_id_hints"].GetArray()) {
-        model.ending_id_hints.emplace_back(endingId.GetInt());
-      }
-    }
-
-    if (issue.HasMember("stat_changes") && issue["stat_changes"].IsArray()) {
-      model.stat_delta = Stats::FromJson(issue["stat_changes"].GetArray());
-    }
-
-    if (!m_issuesByType.count(model.type)) {
-      m_issuesByType[model.type] = {model.id};
-    } else {
-      m_issuesByType[model.type].push_back(model.id);
-    }
-    auto id = model.id;
-    m_issuesById[id] = std::move(model);
   }
+  updateEligibility();
 }
 
-IssueModel &Issues::getIssue(int32_t id) {
-  if (m_issuesById.count(id)) {
-    return m_issuesById[id];
-  }
-
-  spdlog::warn("Requested issue id {} that does not exist.", id);
-  return kEmptyIssueModel;
+const IssueModel &Issues::getIssue(int32_t id) const {
+  return m_catalog.getIssue(id);
 }
 
-void Issues::handleIssue(int32_t issueId, const std::shared_ptr<IEventObserver> &observer) {
-  IssueModel &issue = getIssue(issueId);
+void Issues::handleIssue(int32_t issueId,
+                         const std::shared_ptr<IEventObserver> &observer,
+                         std::function<void()> then) {
+  const IssueModel &issue = getIssue(issueId);
+  auto &decision = m_chosenActions.ask(issueId);
   bool shouldHandle = observer && observer->onIssueOccurred(issue);
-  if (!shouldHandle) { return; }
+  if (!shouldHandle) {
+    if (observer) { m_game.recordInput({JournalEntry::Type::ISSUE_DECLINED, issueId}); }
+    if (then) { then(); }
+    return;
+  }
 
   spdlog::debug("Handling issue {}", issueId);
 
@@ -128,28 +63,43 @@ void Issues::handleIssue(int32_t issueId, const std::shared_ptr<IEventObserver>
     m_game.pushEndingHintId(endingId);
   }
 
-  auto actionId = issue.chosenAction().get();
-  m_game.getActions().handleAction(actionId, observer);
-
-  // A valid issue exists. Mark it as having happened and apply the stat delta
-  m_issuesThatHaveAlreadyHappened.insert(issueId);
-  m_game.updateStats(issue.stat_delta);
+  m_game.awaitInput(decision, [this, &decision, observer, issueId, then]() {
+    m_game.recordInput({JournalEntry::Type::ISSUE_ACTION, issueId, decision.get()});
+    m_game.getActions().handleAction(decision.get(), observer, [this, issueId, then]() {
+      // A valid issue exists. Mark it as having happened and apply the stat delta
+      if (m_issuesThatHaveAlreadyHappened.insert(issueId).second) {
+        m_game.getUnsavedChanges().happened_issue_ids.push_back(issueId);
+        updateEligibility(issueId);
+      }
+      m_game.updateStats(getIssue(issueId).stat_delta);
+      if (then) { then(); }
+    });
+  });
 }
 
 int32_t Issues::popRandomIssueId(IssueModel::Type type) {
-  std::vector<int32_t> potential_issues;
+  if (type != IssueModel::Type::HEALTH && type != IssueModel::Type::MECHANICAL) { return -1; }
+  const auto &eligible = type == IssueModel::Type::HEALTH ? m_eligibleHealthIssues : m_eligibleMechanicalIssues;
+
+  // Picks the same issue as choosing from a list of just the eligible ones would
+  const auto eligibleCount = eligible.weights.total();
+  if (eligibleCount <= 0) { return -1; }
+  const auto draw = m_game.getIssueRng().nextBelow(static_cast<uint64_t>(eligibleCount));
+  const auto position = eligible.weights.upperBound(static_cast<int32_t>(draw));
+  return m_catalog.getIssueIds(type)[position];
+}
 
-  // Get a list of all issues of `type` that haven't happened yet
-  std::copy_if(m_issuesByType[type].begin(), m_issuesByType[type].end(),
-               std::back_inserter(potential_issues),
-               [this](const int32_t id) { return canServeIssue(id); });
+bool Issues::chooseAction(int32_t issueId, int32_t actionId) {
+  if (getIssue(issueId).actionIdIsValid(actionId)) {
+    return chosenAction(issueId).decide(actionId);
+  }
 
-  // Shuffle the issues
-  auto seed = std::chrono::system_clock::now().time_since_epoch().count();
-  std::shuffle(potential_issues.begin(), potential_issues.end(), std::default_random_engine(seed));
+  spdlog::warn("{} is an invalid action id for this issue!", actionId);
+  return false;
+}
 
-  if (potential_issues.empty()) { return -1; }
-  else { return potential_issues[0]; }
+Decision<int32_t> &Issues::chosenAction(int32_t issueId) {
+  return m_chosenActions.get(issueId);
 }
 
 std::unordered_set<int32_t> Issues::getIssuesThatHaveAlreadyHappened() const {
@@ -159,26 +109,75 @@ std::unordered_set<int32_t> Issues::getIssuesThatHaveAlreadyHappened() const {
 void Issues::setIssuesThatHaveAlreadyHappened(std::unordered_set<int32_t> ids) {
   for (const auto &id : ids) {
     m_issuesThatHaveAlreadyHappened.insert(id);
+    updateEligibility(id);
   }
 }
 
 bool Issues::canServeIssue(int32_t id) const {
-  auto &issue = m_issuesById.at(id);
+  // Issue can't be served if its dependent actions haven't happened or its
+  // dependent items aren't in the inventory
+  const auto &dependencies = m_catalog.getIssueDependencies(id);
+  return dependencies.satisfiable &&
+         m_happenedActions.containsAll(dependencies.actions) &&
+         m_ownedItems.containsAll(dependencies.items) &&
+         !m_issuesThatHaveAlreadyHappened.count(id);
+}
 
-  // Issue can't be served if its dependent actions haven't happened
-  if (!issue.dependent_actions.empty()) {
-    auto &actions = m_game.getActions();
-    for (const auto &action_id : issue.dependent_actions) {
-      if (!actions.actionHasHappened(action_id)) { return false; }
-    }
+void Issues::updateEligibility(int32_t issueId) {
+  auto position = m_issuePositions.find(issueId);
+  if (position == m_issuePositions.end()) { return; }
+
+  auto &eligible = getIssue(issueId).type == IssueModel::Type::HEALTH ? m_eligibleHealthIssues
+                                                                       : m_eligibleMechanicalIssues;
+  eligible.set(position->second, canServeIssue(issueId));
+}
+
+void Issues::EligibleIssues::set(size_t position, bool eligible) {
+  if (position >= bits.size() || bits.test(position) == eligible) { return; }
+  bits.set(position, eligible);
+  weights.add(position, eligible ? 1 : -1);
+}
+
+void Issues::updateEligibility() {
+  for (const auto &idPositionPair : m_issuePositions) {
+    updateEligibility(idPositionPair.first);
   }
+}
 
-  // Issue can't be served if its dependent items aren't in the inventory
-  if (!issue.dependent_inventory.empty()) {
-    for (const auto &item_id : issue.dependent_inventory) {
-      if (!m_game.inventoryCount(item_id)) { return false; }
-    }
+void Issues::actionHappened(int32_t actionId) {
+  auto index = m_catalog.getActionIndex(actionId);
+  if (index < 0 || m_happenedActions.test(index)) { return; }
+  m_happenedActions.set(index);
+  for (auto issueId : m_catalog.getIssueIdsDependingOnAction(actionId)) {
+    updateEligibility(issueId);
   }
+}
 
-  return !m_issuesThatHaveAlreadyHappened.count(id);
+void Issues::actionsChanged() {
+  m_happenedActions.reset();
+  for (auto actionId : m_game.getActions().getActionsThatHaveAlreadyHappened()) {
+    auto index = m_catalog.getActionIndex(actionId);
+    if (index >= 0) { m_happenedActions.set(index); }
+  }
+  updateEligibility();
+}
+
+void Issues::inventoryChanged(int32_t itemId) {
+  auto index = m_catalog.getItemIndex(itemId);
+  if (index < 0) { return; }
+  const bool owned = m_game.inventoryCount(itemId) > 0;
+  if (m_ownedItems.test(index) == owned) { return; }
+  m_ownedItems.set(index, owned);
+  for (auto issueId : m_catalog.getIssueIdsDependingOnItem(itemId)) {
+    updateEligibility(issueId);
+  }
+}
+
+void Issues::inventoryChanged() {
+  m_ownedItems.reset();
+  for (const auto &[id, quantity] : m_game.getInventoryCounts()) {
+    auto index = m_catalog.getItemIndex(id);
+    if (index >= 0) { m_ownedItems.set(index); }
+  }
+  updateEligibility();
 }
@@ -17,61 +17,13 @@
 
 #include <libgtfoklahoma/items.hpp>
 
-#include <utility>
-
-#include <rapidjson/document.h>
-#include <spdlog/spdlog.h>
+#include <libgtfoklahoma/content_catalog.hpp>
 
 using namespace libgtfoklahoma;
 
-Items::Items(const char *itemsJson) {
-
-  rapidjson::Document  itemsDocument;
-  if (itemsDocument.Parse(itemsJson).HasParseError() ||
-      !itemsDocument.IsArray()) {
-    spdlog::error("Error parsing items JSON");
-    abort();
-  }
-
-  auto get_category = [](const std::string &category){
-    if (category == "BIKE") { return ItemModel::Category::BIKE; }
-    if (category == "MISC") { return ItemModel::Category::MISC; }
-
-    return ItemModel::Category::INVALID;
-  };
-
-  auto item_is_valid = [](const rapidjson::Value &item) {
-    return item.HasMember("id") && item["id"].IsInt() &&
-           item.HasMember("category") && item["category"].IsString() &&
-           item.HasMember("cost") && item["cost"].IsInt() &&
-           item.HasMember("display_name") && item["display_name"].IsString() &&
-           item.HasMember("image_url") && item["image_url"].IsString() &&
-           item.HasMember("stat_changes") && item["stat_changes"].IsArray();
-  };
-
-  for (const auto &item : itemsDocument.GetArray()) {
-    ItemModel model;
-    if (!item_is_valid(item)) {
-      spdlog::warn("Unable to parse an item! Skipping it.");
-      continue;
-    }
-
-    model.id = item["id"].GetInt();
-    model.category = get_category(item["category"].GetString());
-    model.cost = item["cost"].GetInt();
-    model.display_name = item["display_name"].GetString();
-    model.image_url = item["image_url"].GetString();
-    model.stat_delta = Stats::FromJson(item["stat_changes"].GetArray());
-
-    m_items[model.id] = model;
-  }
-}
-
-ItemModel &Items::getItem(int32_t id) {
-  if (m_items.count(id)) {
-      return m_items[id];
-  }
+Items::Items(const ContentCatalog &catalog)
+: m_catalog(catalog) {}
 
-  spdlog::warn("Requested item id {} that does not exist.", id);
-  return kEmptyItemModel;
+const ItemModel &Items::getItem(int32_t id) const {
+  return m_catalog.getItem(id);
 }
@@ -0,0 +1,406 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/journal.hpp>
+
+// System includes
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+// 3P Includes
+#include <spdlog/spdlog.h>
+
+// Local includes
+#include <libgtfoklahoma/engine.hpp>
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/pacing.hpp>
+
+using namespace libgtfoklahoma;
+
+namespace {
+const char kMagic[4] = {'G', 'T', 'F', 'J'};
+
+// Everything is little-endian, small integers are zigzag varints
+class Writer {
+public:
+  explicit Writer(std::vector<uint8_t> &out) : m_out(out) {}
+
+  void u8(uint8_t value) { m_out.push_back(value); }
+
+  void fixed(uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+      m_out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+
+  void varint(uint64_t value) {
+    while (value >= 0x80) {
+      m_out.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7u;
+    }
+    m_out.push_back(static_cast<uint8_t>(value));
+  }
+
+  void i32(int32_t value) {
+    varint((static_cast<uint32_t>(value) << 1u) ^ static_cast<uint32_t>(value >> 31));
+  }
+
+  void f64(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    fixed(bits, sizeof(bits));
+  }
+
+private:
+  std::vector<uint8_t> &m_out;
+};
+
+// Every read fails once any read has run off the end
+class Reader {
+public:
+  Reader(const uint8_t *data, size_t size) : m_data(data), m_size(size) {}
+
+  bool u8(uint8_t &value) {
+    if (m_pos >= m_size) { return false; }
+    value = m_data[m_pos++];
+    return true;
+  }
+
+  bool fixed(uint64_t &value, size_t bytes) {
+    if (m_size - m_pos < bytes) { return false; }
+    value = 0;
+    for (size_t i = 0; i < bytes; i++) {
+      value |= static_cast<uint64_t>(m_data[m_pos++]) << (8 * i);
+    }
+    return true;
+  }
+
+  bool varint(uint64_t &value) {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!u8(byte)) { return false; }
+      value |= static_cast<uint64_t>(byte & 0x7fu) << shift;
+      if (!(byte & 0x80u)) { return true; }
+    }
+    return false;
+  }
+
+  bool i32(int32_t &value) {
+    uint64_t raw;
+    if (!varint(raw) || raw > UINT32_MAX) { return false; }
+    auto zigzag = static_cast<uint32_t>(raw);
+    value = static_cast<int32_t>((zigzag >> 1u) ^ -(zigzag & 1u));
+    return true;
+  }
+
+  bool f64(double &value) {
+    uint64_t bits;
+    if (!fixed(bits, sizeof(bits))) { return false; }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+  }
+
+  [[nodiscard]] bool atEnd() const { return m_pos == m_size; }
+
+private:
+  const uint8_t *m_data;
+  size_t m_size;
+  size_t m_pos{0};
+};
+
+void writeStats(Writer &writer, const StatModel &stats) {
+  writer.i32(stats.bedtime_hour);
+  writer.i32(stats.health);
+  writer.i32(stats.kit_weight);
+  writer.i32(stats.max_mph);
+  writer.i32(stats.money_remaining);
+  writer.f64(stats.odds_health_issue);
+  writer.f64(stats.odds_mech_issue);
+  writer.u8(static_cast<uint8_t>(stats.pace));
+  writer.i32(stats.wakeup_hour);
+}
+
+bool readStats(Reader &reader, StatModel &stats) {
+  uint8_t pace;
+  bool ok = reader.i32(stats.bedtime_hour) &&
+            reader.i32(stats.health) &&
+            reader.i32(stats.kit_weight) &&
+            reader.i32(stats.max_mph) &&
+            reader.i32(stats.money_remaining) &&
+            reader.f64(stats.odds_health_issue) &&
+            reader.f64(stats.odds_mech_issue) &&
+            reader.u8(pace) &&
+            reader.i32(stats.wakeup_hour);
+  if (!ok || pace > static_cast<uint8_t>(StatModel::Pace::MERCKX)) { return false; }
+  stats.pace = static_cast<StatModel::Pace>(pace);
+  return true;
+}
+
+// Feeds the journal's inputs back to the game as it asks for them
+class ReplayObserver : public IEventObserver {
+public:
+  ReplayObserver(Game &game, const Journal &journal)
+  : IEventObserver(game)
+  , m_entries(journal.getEntries()) {}
+
+  void onGameOver(const EndingModel &ending) override { m_endingId = ending.id; }
+  void onHourChanged(int32_t) override {}
+  void onMileChanged(int32_t) override {}
+  void onStatsChanged(const StatModel &) override {}
+
+  bool onEvent(const EventModel &event) override {
+    if (skipIfDeclined(JournalEntry::Type::EVENT_DECLINED, event.id)) { return false; }
+    auto entry = next(JournalEntry::Type::EVENT_ACTION, event.id);
+    return entry && m_game.getEvents().chooseAction(event.id, entry->value);
+  }
+
+  bool onIssueOccurred(const IssueModel &issue) override {
+    if (skipIfDeclined(JournalEntry::Type::ISSUE_DECLINED, issue.id)) { return false; }
+    auto entry = next(JournalEntry::Type::ISSUE_ACTION, issue.id);
+    return entry && m_game.getIssues().chooseAction(issue.id, entry->value);
+  }
+
+  bool onStoreEntered(const ActionModel &action) override {
+    while (peekIs(JournalEntry::Type::PURCHASE, action.id)) {
+      if (!m_game.getActions().purchaseItem(action.id, m_entries[m_cursor++].value)) {
+        m_mismatch = fmt::format("Couldn't repeat purchase in store {}", action.id);
+        return false;
+      }
+    }
+    if (!next(JournalEntry::Type::LEAVE_STORE, action.id)) { return false; }
+    m_game.getActions().completePurchase(action.id);
+    return true;
+  }
+
+  [[nodiscard]] int32_t endingId() const { return m_endingId; }
+  [[nodiscard]] bool finished() const { return m_cursor == m_entries.size(); }
+  [[nodiscard]] const std::string &mismatch() const { return m_mismatch; }
+
+private:
+  bool peekIs(JournalEntry::Type type, int32_t id) const {
+    return m_cursor < m_entries.size() &&
+           m_entries[m_cursor].type == type &&
+           m_entries[m_cursor].id == id;
+  }
+
+  bool skipIfDeclined(JournalEntry::Type type, int32_t id) {
+    if (!peekIs(type, id)) { return false; }
+    m_cursor++;
+    return true;
+  }
+
+  const JournalEntry *next(JournalEntry::Type type, int32_t id) {
+    if (!peekIs(type, id)) {
+      if (m_mismatch.empty()) {
+        m_mismatch = fmt::format("Game asked for input {} on {} but the journal has {} entries left",
+                                 static_cast<int>(type), id, m_entries.size() - m_cursor);
+      }
+      return nullptr;
+    }
+    return &m_entries[m_cursor++];
+  }
+
+  const std::vector<JournalEntry> &m_entries;
+  size_t m_cursor{0};
+  int32_t m_endingId{-1};
+  std::string m_mismatch;
+};
+} // namespace
+
+bool JournalEntry::operator==(const JournalEntry &rhs) const {
+  return this->type == rhs.type &&
+         this->id == rhs.id &&
+         this->value == rhs.value;
+}
+
+bool JournalOutcome::operator==(const JournalOutcome &rhs) const {
+  return this->ending_id == rhs.ending_id &&
+         this->hour == rhs.hour &&
+         this->mile == rhs.mile &&
+         this->stats == rhs.stats;
+}
+
+Journal::Journal(uint64_t seed, uint64_t contentHash)
+: m_seed(seed)
+, m_contentHash(contentHash) {}
+
+void Journal::append(JournalEntry entry) { m_entries.push_back(entry); }
+void Journal::setOutcome(JournalOutcome outcome) { m_outcome = std::move(outcome); }
+
+uint64_t Journal::getSeed() const { return m_seed; }
+uint64_t Journal::getContentHash() const { return m_contentHash; }
+const std::vector<JournalEntry> &Journal::getEntries() const { return m_entries; }
+const std::optional<JournalOutcome> &Journal::getOutcome() const { return m_outcome; }
+
+std::vector<uint8_t> Journal::serialize() const {
+  std::vector<uint8_t> out;
+  out.reserve(32 + m_entries.size() * 4);
+  Writer writer(out);
+
+  out.insert(out.end(), std::begin(kMagic), std::end(kMagic));
+  writer.fixed(kVersion, sizeof(kVersion));
+  writer.fixed(m_seed, sizeof(m_seed));
+  writer.fixed(m_contentHash, sizeof(m_contentHash));
+
+  writer.varint(m_entries.size());
+  for (const auto &entry : m_entries) {
+    writer.u8(static_cast<uint8_t>(entry.type));
+    writer.i32(entry.id);
+    writer.i32(entry.value);
+  }
+
+  writer.u8(m_outcome.has_value());
+  if (m_outcome) {
+    writer.i32(m_outcome->ending_id);
+    writer.i32(m_outcome->hour);
+    writer.i32(m_outcome->mile);
+    writeStats(writer, m_outcome->stats);
+  }
+  return out;
+}
+
+std::optional<Journal> Journal::Deserialize(const uint8_t *data, size_t size) {
+  if (size < sizeof(kMagic) || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+    spdlog::warn("Not a journal");
+    return std::nullopt;
+  }
+  Reader reader(data + sizeof(kMagic), size - sizeof(kMagic));
+
+  uint64_t version;
+  Journal journal;
+  if (!reader.fixed(version, sizeof(kVersion)) || version != kVersion) {
+    spdlog::warn("Unsupported journal version {}", version);
+    return std::nullopt;
+  }
+
+  uint64_t entryCount;
+  if (!reader.fixed(journal.m_seed, sizeof(journal.m_seed)) ||
+      !reader.fixed(journal.m_contentHash, sizeof(journal.m_contentHash)) ||
+      !reader.varint(entryCount)) {
+    spdlog::warn("Truncated journal header");
+    return std::nullopt;
+  }
+
+  // Every entry takes at least three bytes, don't trust the count beyond that
+  journal.m_entries.reserve(std::min<uint64_t>(entryCount, size / 3));
+  for (uint64_t i = 0; i < entryCount; i++) {
+    uint8_t type;
+    JournalEntry entry;
+    if (!reader.u8(type) || type > static_cast<uint8_t>(JournalEntry::Type::ISSUE_DECLINED) ||
+        !reader.i32(entry.id) || !reader.i32(entry.value)) {
+      spdlog::warn("Bad journal entry {}", i);
+      return std::nullopt;
+    }
+    entry.type = static_cast<JournalEntry::Type>(type);
+    journal.m_entries.push_back(entry);
+  }
+
+  uint8_t hasOutcome;
+  if (!reader.u8(hasOutcome)) { return std::nullopt; }
+  if (hasOutcome) {
+    JournalOutcome outcome;
+    if (!reader.i32(outcome.ending_id) || !reader.i32(outcome.hour) ||
+        !reader.i32(outcome.mile) || !readStats(reader, outcome.stats)) {
+      spdlog::warn("Bad journal outcome");
+      return std::nullopt;
+    }
+    journal.m_outcome = outcome;
+  }
+
+  if (!reader.atEnd()) {
+    spdlog::warn("Trailing bytes after journal");
+    return std::nullopt;
+  }
+  return journal;
+}
+
+bool Journal::writeToFile(const std::string &path) const {
+  auto bytes = serialize();
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+  return static_cast<bool>(file);
+}
+
+std::optional<Journal> Journal::ReadFromFile(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    spdlog::warn("Couldn't open journal {}", path);
+    return std::nullopt;
+  }
+  std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return Deserialize(bytes.data(), bytes.size());
+}
+
+uint64_t libgtfoklahoma::HashContent(std::initializer_list<const char *> json) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  auto mix = [&hash](uint8_t byte) {
+    hash ^= byte;
+    hash *= 0x100000001b3ULL;
+  };
+  for (const auto *piece : json) {
+    for (const auto *c = piece; c && *c; c++) {
+      mix(static_cast<uint8_t>(*c));
+    }
+    // Keep ("ab", "c") and ("a", "bc") apart
+    mix(0);
+  }
+  return hash;
+}
+
+ReplayResult libgtfoklahoma::Replay(const Journal &journal, Game &game, uint32_t maxTicks) {
+  ReplayResult result;
+  if (game.getSeed() != journal.getSeed()) {
+    result.mismatch = "Game wasn't seeded with the journal's seed";
+    return result;
+  }
+  if (game.getContentHash() != journal.getContentHash()) {
+    result.mismatch = "Journal was recorded with different content";
+    return result;
+  }
+
+  auto observer = std::make_shared<ReplayObserver>(game, journal);
+  game.registerEventObserver(observer);
+
+  Engine engine(game, std::make_shared<UnthrottledPacing>());
+  auto status = Engine::Status::RUNNING;
+  while (status == Engine::Status::RUNNING && engine.getCurrentTick() < maxTicks) {
+    status = engine.advance();
+  }
+
+  result.outcome.ending_id = observer->endingId();
+  result.outcome.hour = game.getCurrentHour();
+  result.outcome.mile = game.getCurrentMile();
+  result.outcome.stats = game.getStats().getPlayerStatsModel();
+
+  if (!observer->mismatch().empty()) {
+    result.mismatch = observer->mismatch();
+  } else if (status != Engine::Status::GAME_OVER) {
+    result.mismatch = "Game didn't finish";
+  } else if (!observer->finished()) {
+    result.mismatch = "Game finished before the journal did";
+  } else if (!journal.getOutcome()) {
+    result.mismatch = "Journal has no outcome to compare with";
+  } else if (!(*journal.getOutcome() == result.outcome)) {
+    result.mismatch = "Game ended differently";
+  }
+  result.matches = result.mismatch.empty();
+  return result;
+}
@@ -0,0 +1,40 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/observer_registry.hpp>
+
+#include <utility>
+
+using namespace libgtfoklahoma;
+
+ObserverRegistry::ObserverRegistry()
+: m_current(nullptr) {
+  m_lists.emplace_back(std::make_unique<const List>());
+  m_current.store(m_lists.back().get(), std::memory_order_release);
+}
+
+void ObserverRegistry::add(std::shared_ptr<IEventObserver> observer) {
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+  auto next = std::make_unique<List>(*m_lists.back());
+  next->emplace_back(std::move(observer));
+  m_lists.emplace_back(std::move(next));
+  m_current.store(m_lists.back().get(), std::memory_order_release);
+}
+
+const ObserverRegistry::List &ObserverRegistry::get() const {
+  return *m_current.load(std::memory_order_acquire);
+}
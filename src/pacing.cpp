@@ -0,0 +1,45 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/pacing.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <libgtfoklahoma/rules.hpp>
+
+using namespace libgtfoklahoma;
+
+std::chrono::nanoseconds RealTimePacing::delayForTicks(uint32_t ticks) const {
+  return rules::kTickDelayMs * ticks;
+}
+
+ScaledPacing::ScaledPacing(double speed)
+: m_speed(speed) {
+  if (m_speed <= 0) {
+    spdlog::warn("Pacing speed must be positive, falling back to real-time.");
+    m_speed = 1;
+  }
+}
+
+std::chrono::nanoseconds ScaledPacing::delayForTicks(uint32_t ticks) const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      rules::kTickDelayMs * ticks / m_speed);
+}
+
+std::chrono::nanoseconds UnthrottledPacing::delayForTicks(uint32_t) const {
+  return std::chrono::nanoseconds::zero();
+}
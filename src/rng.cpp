@@ -0,0 +1,90 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/rng.hpp>
+
+#include <random>
+
+using namespace libgtfoklahoma;
+
+namespace {
+uint64_t splitMix64(uint64_t &x) {
+  uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27u)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31u);
+}
+}
+
+Rng::Rng(uint64_t seed, uint64_t stream) {
+  // Mix the stream in before expanding so nearby seeds and streams don't overlap
+  uint64_t x = seed ^ splitMix64(stream);
+  for (auto &word : m_state) {
+    word = splitMix64(x);
+  }
+}
+
+uint64_t Rng::RandomSeed() {
+  std::random_device rd;
+  return (static_cast<uint64_t>(rd()) << 32u) ^ rd();
+}
+
+uint64_t Rng::nextBelow(uint64_t bound) {
+  // Rejection sampling to avoid modulo bias
+  const auto threshold = -bound % bound;
+  while (true) {
+    auto value = next();
+    if (value >= threshold) { return value % bound; }
+  }
+}
+
+void RngBatch::add(const Rng &rng) {
+  const auto &state = rng.getState();
+  m_s0.push_back(state[0]);
+  m_s1.push_back(state[1]);
+  m_s2.push_back(state[2]);
+  m_s3.push_back(state[3]);
+}
+
+Rng::State RngBatch::getState(size_t lane) const {
+  return {m_s0[lane], m_s1[lane], m_s2[lane], m_s3[lane]};
+}
+
+const std::vector<double> &RngBatch::nextDoubles() {
+  const auto lanes = size();
+  m_draws.resize(lanes);
+
+  // Same steps as Rng::next(), written out so each lane is independent
+  auto *s0 = m_s0.data();
+  auto *s1 = m_s1.data();
+  auto *s2 = m_s2.data();
+  auto *s3 = m_s3.data();
+  auto *draws = m_draws.data();
+  for (size_t i = 0; i < lanes; i++) {
+    const uint64_t x = s1[i] * 5;
+    const uint64_t result = ((x << 7u) | (x >> 57u)) * 9;
+    const uint64_t t = s1[i] << 17u;
+    s2[i] ^= s0[i];
+    s3[i] ^= s1[i];
+    s1[i] ^= s2[i];
+    s0[i] ^= s3[i];
+    s2[i] ^= t;
+    s3[i] = (s3[i] << 45u) | (s3[i] >> 19u);
+    draws[i] = static_cast<double>(result >> 11u) * 0x1.0p-53;
+  }
+  return m_draws;
+}
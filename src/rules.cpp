@@ -19,28 +19,70 @@
 
 #include <cmath>
 
+#include <spdlog/spdlog.h>
+
 #include <libgtfoklahoma/action_model.hpp>
+#include <libgtfoklahoma/stat_batch.hpp>
 #include <libgtfoklahoma/stat_model.hpp>
 
 using namespace libgtfoklahoma;
 using namespace libgtfoklahoma::rules;
 
-bool libgtfoklahoma::rules::ActionIsSuccessful(const libgtfoklahoma::ActionModel &action) {
-  return randomGenerator(gen) <= action.success_chance;
+namespace {
+void issuesThisHour(const std::vector<double> &odds, RngBatch &rngs, std::vector<uint8_t> &result) {
+  const auto riders = odds.size();
+  if (rngs.size() != riders) {
+    spdlog::error("Batch has {} riders but {} rngs", riders, rngs.size());
+    result.assign(riders, 0);
+    return;
+  }
+
+  // Raw pointers, otherwise every byte stored could alias the vectors themselves and nothing vectorizes
+  const auto *draws = rngs.nextDoubles().data();
+  const auto *odd = odds.data();
+  result.resize(riders);
+  auto *hit = result.data();
+  for (size_t i = 0; i < riders; i++) {
+    hit[i] = draws[i] <= odd[i];
+  }
+}
+}
+
+bool libgtfoklahoma::rules::ActionIsSuccessful(const libgtfoklahoma::ActionModel &action, Rng &rng) {
+  return rng.nextDouble() <= action.success_chance;
 }
 
-bool libgtfoklahoma::rules::HealthIssueThisHour(const libgtfoklahoma::StatModel &stats) {
-  return randomGenerator(gen) <= stats.odds_health_issue;
+bool libgtfoklahoma::rules::HealthIssueThisHour(const libgtfoklahoma::StatModel &stats, Rng &rng) {
+  return rng.nextDouble() <= stats.odds_health_issue;
 }
 
-bool libgtfoklahoma::rules::MechanicalIssueThisHour(const libgtfoklahoma::StatModel &stats) {
-  return randomGenerator(gen) <= stats.odds_mech_issue;
+bool libgtfoklahoma::rules::MechanicalIssueThisHour(const libgtfoklahoma::StatModel &stats, Rng &rng) {
+  return rng.nextDouble() <= stats.odds_mech_issue;
+}
+
+void libgtfoklahoma::rules::HealthIssuesThisHour(const StatBatch &stats, RngBatch &rngs, std::vector<uint8_t> &result) {
+  issuesThisHour(stats.odds_health_issue, rngs, result);
+}
+
+void libgtfoklahoma::rules::MechanicalIssuesThisHour(const StatBatch &stats, RngBatch &rngs, std::vector<uint8_t> &result) {
+  issuesThisHour(stats.odds_mech_issue, rngs, result);
 }
 
 int32_t libgtfoklahoma::rules::RealSpeed(const StatModel &stats) {
   return round(stats.max_mph * exp(-kWeightLambda * stats.kit_weight));
 }
 
+void libgtfoklahoma::rules::RealSpeeds(const StatBatch &stats, std::vector<int32_t> &result) {
+  const auto riders = stats.size();
+  const auto *maxMph = stats.max_mph.data();
+  const auto *kitWeight = stats.kit_weight.data();
+  result.resize(riders);
+  auto *speed = result.data();
+  for (size_t i = 0; i < riders; i++) {
+    speed[i] = round(maxMph[i] * exp(-kWeightLambda * kitWeight[i]));
+  }
+}
+
 int32_t libgtfoklahoma::rules::TicksUntilNextMile(const StatModel &stats) {
   return kTicksPerGameHour / RealSpeed(stats);
 }
\ No newline at end of file
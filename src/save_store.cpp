@@ -0,0 +1,346 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/save_store.hpp>
+
+// System includes
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <unordered_set>
+
+// 3P Includes
+#include <spdlog/spdlog.h>
+#include <sqlite_orm/sqlite_orm.h>
+
+// Local includes
+#include <libgtfoklahoma/game.hpp>
+
+using namespace libgtfoklahoma;
+
+namespace {
+// Everything that's cheap to rewrite on every checkpoint lives in one row
+struct GameRow {
+  int64_t id;
+  int64_t seed;
+  int64_t content_hash;
+  int32_t current_hour;
+  int32_t current_mile;
+  int32_t bedtime_hour;
+  int32_t health;
+  int32_t kit_weight;
+  int32_t max_mph;
+  int32_t money_remaining;
+  double odds_health_issue;
+  double odds_mech_issue;
+  int32_t pace;
+  int32_t wakeup_hour;
+  std::vector<char> ending_hints; // Packed int32s, bottom of the stack first
+  std::vector<char> rng_state;    // Action stream then issue stream
+};
+
+struct InventoryRow {
+  int64_t game_id;
+  int32_t item_id;
+  int32_t quantity;
+};
+
+struct HappenedActionRow {
+  int64_t game_id;
+  int32_t action_id;
+};
+
+struct HappenedIssueRow {
+  int64_t game_id;
+  int32_t issue_id;
+};
+
+auto makeStorage(const std::string &path) {
+  using namespace sqlite_orm;
+  return make_storage(
+      path,
+      make_table("games",
+                 make_column("id", &GameRow::id, primary_key()),
+                 make_column("seed", &GameRow::seed),
+                 make_column("content_hash", &GameRow::content_hash),
+                 make_column("current_hour", &GameRow::current_hour),
+                 make_column("current_mile", &GameRow::current_mile),
+                 make_column("bedtime_hour", &GameRow::bedtime_hour),
+                 make_column("health", &GameRow::health),
+                 make_column("kit_weight", &GameRow::kit_weight),
+                 make_column("max_mph", &GameRow::max_mph),
+                 make_column("money_remaining", &GameRow::money_remaining),
+                 make_column("odds_health_issue", &GameRow::odds_health_issue),
+                 make_column("odds_mech_issue", &GameRow::odds_mech_issue),
+                 make_column("pace", &GameRow::pace),
+                 make_column("wakeup_hour", &GameRow::wakeup_hour),
+                 make_column("ending_hints", &GameRow::ending_hints),
+                 make_column("rng_state", &GameRow::rng_state)),
+      make_table("inventory",
+                 make_column("game_id", &InventoryRow::game_id),
+                 make_column("item_id", &InventoryRow::item_id),
+                 make_column("quantity", &InventoryRow::quantity),
+                 primary_key(&InventoryRow::game_id, &InventoryRow::item_id)),
+      make_table("happened_actions",
+                 make_column("game_id", &HappenedActionRow::game_id),
+                 make_column("action_id", &HappenedActionRow::action_id),
+                 primary_key(&HappenedActionRow::game_id, &HappenedActionRow::action_id)),
+      make_table("happened_issues",
+                 make_column("game_id", &HappenedIssueRow::game_id),
+                 make_column("issue_id", &HappenedIssueRow::issue_id),
+                 primary_key(&HappenedIssueRow::game_id, &HappenedIssueRow::issue_id)));
+}
+
+template<typename T>
+std::vector<char> pack(const T *values, size_t count) {
+  std::vector<char> result(count * sizeof(T));
+  if (count) { std::memcpy(result.data(), values, result.size()); }
+  return result;
+}
+
+template<typename T>
+std::vector<T> unpack(const std::vector<char> &blob) {
+  std::vector<T> result(blob.size() / sizeof(T));
+  if (!result.empty()) { std::memcpy(result.data(), blob.data(), result.size() * sizeof(T)); }
+  return result;
+}
+
+GameRow toRow(SaveStore::SaveId id, Game &game) {
+  const auto &stats = game.getStats().getPlayerStatsModel();
+  auto hints = game.getEndingHintIds();
+
+  std::vector<uint64_t> rngState;
+  for (auto *rng : {&game.getActionRng(), &game.getIssueRng()}) {
+    rngState.insert(rngState.end(), rng->getState().begin(), rng->getState().end());
+  }
+
+  return GameRow{
+      id,
+      static_cast<int64_t>(game.getSeed()),
+      static_cast<int64_t>(game.getContentHash()),
+      game.getCurrentHour(),
+      game.getCurrentMile(),
+      stats.bedtime_hour,
+      stats.health,
+      stats.kit_weight,
+      stats.max_mph,
+      stats.money_remaining,
+      stats.odds_health_issue,
+      stats.odds_mech_issue,
+      static_cast<int32_t>(stats.pace),
+      stats.wakeup_hour,
+      pack(hints.data(), hints.size()),
+      pack(rngState.data(), rngState.size())};
+}
+} // namespace
+
+using Storage = decltype(makeStorage(""));
+struct SaveStore::Impl {
+  explicit Impl(const std::string &path)
+  : storage(makeStorage(path)) {}
+
+  Storage storage;
+};
+
+SaveStore::SaveStore(const std::string &path)
+: m_impl(std::make_unique<Impl>(path)) {
+  auto &storage = m_impl->storage;
+
+  // Keep the connection (and with it the WAL) open rather than reopening per query
+  storage.open_forever();
+  storage.sync_schema();
+  storage.pragma.journal_mode(sqlite_orm::journal_mode::WAL);
+
+  // Safe with WAL, only the last commits are at risk if the machine loses power
+  storage.pragma.synchronous(1);
+}
+
+SaveStore::~SaveStore() = default;
+
+// Changes are only let go of once they're committed, so if a transaction
+// throws the next checkpoint picks them up again
+bool SaveStore::save(SaveId id, Game &game) {
+  if (!canSave(id, game)) { return false; }
+  m_impl->storage.transaction([&]() {
+    writeGame(id, game, true);
+    return true;
+  });
+  game.takeUnsavedChanges();
+  return true;
+}
+
+bool SaveStore::checkpoint(SaveId id, Game &game) {
+  if (!canSave(id, game)) { return false; }
+  m_impl->storage.transaction([&]() {
+    writeGame(id, game, false);
+    return true;
+  });
+  game.takeUnsavedChanges();
+  return true;
+}
+
+bool SaveStore::checkpoint(const std::vector<GameRef> &games) {
+  std::vector<GameRef> saveable;
+  saveable.reserve(games.size());
+  for (const auto &ref : games) {
+    if (canSave(ref.first, ref.second)) { saveable.push_back(ref); }
+  }
+
+  m_impl->storage.transaction([&]() {
+    for (const auto &[id, game] : saveable) {
+      writeGame(id, game, false);
+    }
+    return true;
+  });
+  for (const auto &[id, game] : saveable) {
+    game.get().takeUnsavedChanges();
+  }
+  return saveable.size() == games.size();
+}
+
+bool SaveStore::canSave(SaveId id, const Game &game) {
+  if (game.awaitingInput()) {
+    spdlog::warn("Not saving {}, it's waiting on the player", id);
+    return false;
+  }
+  return true;
+}
+
+void SaveStore::writeGame(SaveId id, Game &game, bool full) {
+  using namespace sqlite_orm;
+  auto &storage = m_impl->storage;
+  const auto &changes = game.getUnsavedChanges();
+  storage.replace(toRow(id, game));
+
+  if (full) {
+    storage.remove_all<InventoryRow>(where(c(&InventoryRow::game_id) == id));
+    storage.remove_all<HappenedActionRow>(where(c(&HappenedActionRow::game_id) == id));
+    storage.remove_all<HappenedIssueRow>(where(c(&HappenedIssueRow::game_id) == id));
+
+    for (const auto &[itemId, quantity] : game.getInventoryCounts()) {
+      storage.replace(InventoryRow{id, itemId, quantity});
+    }
+    for (auto actionId : game.getActions().getActionsThatHaveAlreadyHappened()) {
+      storage.replace(HappenedActionRow{id, actionId});
+    }
+    for (auto issueId : game.getIssues().getIssuesThatHaveAlreadyHappened()) {
+      storage.replace(HappenedIssueRow{id, issueId});
+    }
+    return;
+  }
+
+  const auto &inventory = game.getInventoryCounts();
+  for (auto itemId : changes.inventory_ids) {
+    auto item = inventory.find(itemId);
+    if (!item) {
+      storage.remove_all<InventoryRow>(
+          where(c(&InventoryRow::game_id) == id && c(&InventoryRow::item_id) == itemId));
+    } else {
+      storage.replace(InventoryRow{id, itemId, item->quantity});
+    }
+  }
+  for (auto actionId : changes.happened_action_ids) {
+    storage.replace(HappenedActionRow{id, actionId});
+  }
+  for (auto issueId : changes.happened_issue_ids) {
+    storage.replace(HappenedIssueRow{id, issueId});
+  }
+}
+
+bool SaveStore::load(SaveId id, Game &game) {
+  using namespace sqlite_orm;
+  auto &storage = m_impl->storage;
+
+  auto row = storage.get_pointer<GameRow>(id);
+  if (!row) {
+    spdlog::warn("No save with id {}", id);
+    return false;
+  }
+  if (static_cast<uint64_t>(row->content_hash) != game.getContentHash() ||
+      static_cast<uint64_t>(row->seed) != game.getSeed()) {
+    spdlog::warn("Save {} was made with a different seed or different content", id);
+    return false;
+  }
+
+  auto rngState = unpack<uint64_t>(row->rng_state);
+  if (rngState.size() != 2 * std::tuple_size<Rng::State>::value) {
+    spdlog::warn("Save {} has a corrupt RNG state", id);
+    return false;
+  }
+  Rng::State state;
+  std::copy_n(rngState.begin(), state.size(), state.begin());
+  game.getActionRng().setState(state);
+  std::copy_n(rngState.begin() + state.size(), state.size(), state.begin());
+  game.getIssueRng().setState(state);
+
+  game.setCurrentHour(row->current_hour);
+  game.setCurrentMile(row->current_mile);
+  game.setEndingHintIds(unpack<int32_t>(row->ending_hints));
+  game.getStats().setPlayerStatsModel(StatModel(row->bedtime_hour,
+                                                row->health,
+                                                row->kit_weight,
+                                                row->max_mph,
+                                                row->money_remaining,
+                                                row->odds_health_issue,
+                                                row->odds_mech_issue,
+                                                static_cast<StatModel::Pace>(row->pace),
+                                                row->wakeup_hour));
+
+  Inventory inventory;
+  for (const auto &item : storage.get_all<InventoryRow>(where(c(&InventoryRow::game_id) == id))) {
+    inventory.add(item.item_id, item.quantity);
+  }
+  game.setInventoryCounts(std::move(inventory));
+
+  std::unordered_set<int32_t> actionIds;
+  for (const auto &action : storage.get_all<HappenedActionRow>(where(c(&HappenedActionRow::game_id) == id))) {
+    actionIds.insert(action.action_id);
+  }
+  game.getActions().setActionsThatHaveAlreadyHappened(std::move(actionIds));
+
+  std::unordered_set<int32_t> issueIds;
+  for (const auto &issue : storage.get_all<HappenedIssueRow>(where(c(&HappenedIssueRow::game_id) == id))) {
+    issueIds.insert(issue.issue_id);
+  }
+  game.getIssues().setIssuesThatHaveAlreadyHappened(std::move(issueIds));
+
+  // Everything loaded is already saved
+  game.takeUnsavedChanges();
+  return true;
+}
+
+std::optional<uint64_t> SaveStore::getSeed(SaveId id) {
+  auto row = m_impl->storage.get_pointer<GameRow>(id);
+  if (!row) { return std::nullopt; }
+  return static_cast<uint64_t>(row->seed);
+}
+
+bool SaveStore::contains(SaveId id) {
+  return m_impl->storage.get_pointer<GameRow>(id) != nullptr;
+}
+
+void SaveStore::remove(SaveId id) {
+  using namespace sqlite_orm;
+  auto &storage = m_impl->storage;
+  storage.transaction([&]() {
+    storage.remove_all<GameRow>(where(c(&GameRow::id) == id));
+    storage.remove_all<InventoryRow>(where(c(&InventoryRow::game_id) == id));
+    storage.remove_all<HappenedActionRow>(where(c(&HappenedActionRow::game_id) == id));
+    storage.remove_all<HappenedIssueRow>(where(c(&HappenedIssueRow::game_id) == id));
+    return true;
+  });
+}
@@ -0,0 +1,325 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/simulator.hpp>
+
+// System includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+// 3P Includes
+#include <spdlog/spdlog.h>
+
+// Local includes
+#include <libgtfoklahoma/engine.hpp>
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/pacing.hpp>
+
+using namespace libgtfoklahoma;
+using namespace libgtfoklahoma::sim;
+
+namespace {
+// Playthroughs are handed out to threads in chunks to keep contention on the counter down
+const uint64_t kPlaythroughsPerChunk = 16;
+
+// Keeps the policy's dice apart from the game's, which share the playthrough's seed
+const uint64_t kPolicyRngStream = 0x706f6c696379;
+
+// Hands every decision straight to the policy so the engine never has to suspend
+class PolicyObserver : public IEventObserver {
+public:
+  PolicyObserver(Game &game, IDecisionPolicy &policy)
+  : IEventObserver(game)
+  , m_policy(policy) {}
+
+  void onGameOver(const EndingModel &ending) override { endingId = ending.id; }
+  void onHourChanged(int32_t) override {}
+  void onMileChanged(int32_t) override {}
+  void onStatsChanged(const StatModel &) override {}
+
+  bool onEvent(const EventModel &event) override {
+    m_game.getEvents().chooseAction(event.id, m_policy.chooseEventAction(m_game, event));
+    return true;
+  }
+
+  bool onIssueOccurred(const IssueModel &issue) override {
+    issuesHit++;
+    m_game.getIssues().chooseAction(issue.id, m_policy.chooseIssueAction(m_game, issue));
+    return true;
+  }
+
+  bool onStoreEntered(const ActionModel &action) override {
+    m_policy.shop(m_game, action);
+    m_game.getActions().completePurchase(action.id);
+    return true;
+  }
+
+  int32_t endingId{-1};
+  int32_t issuesHit{0};
+
+private:
+  IDecisionPolicy &m_policy;
+};
+
+double expectedScore(const ActionModel &action) {
+  auto score = GreedyPolicy::Score(action.stat_delta_regardless);
+
+  // Same as Actions::handleAction, success and failure only count if it can fail
+  if (action.can_fail) {
+    score += action.success_chance * GreedyPolicy::Score(action.stat_delta_on_success) +
+             (1 - action.success_chance) * GreedyPolicy::Score(action.stat_delta_on_failure);
+  }
+  return score;
+}
+
+// Purchases are turned down if the player can't afford them
+bool buyIfInStock(Game &game, const ActionModel &store, int32_t itemId) {
+  return store.itemIsInStock(itemId) && game.getActions().purchaseItem(store.id, itemId);
+}
+} // namespace
+
+RandomPolicy::RandomPolicy(uint64_t seed)
+: m_rng(seed, kPolicyRngStream) {}
+
+int32_t RandomPolicy::chooseEventAction(Game &game, const EventModel &event) {
+  return chooseVisibleAction(game, event.action_ids);
+}
+
+int32_t RandomPolicy::chooseIssueAction(Game &game, const IssueModel &issue) {
+  return chooseVisibleAction(game, issue.actions);
+}
+
+void RandomPolicy::shop(Game &game, const ActionModel &store) {
+  // One item at most, and only half the time
+  if (store.item_ids.empty() || m_rng.nextBelow(2)) { return; }
+  buyIfInStock(game, store, store.item_ids[m_rng.nextBelow(store.item_ids.size())]);
+}
+
+int32_t RandomPolicy::chooseVisibleAction(Game &game, const std::vector<int32_t> &actionIds) {
+  if (actionIds.empty()) { return -1; }
+  std::vector<int32_t> visible;
+  for (auto id : actionIds) {
+    if (game.getActions().isVisible(id)) { visible.push_back(id); }
+  }
+  if (visible.empty()) { return actionIds.front(); }
+  return visible[m_rng.nextBelow(visible.size())];
+}
+
+int32_t GreedyPolicy::chooseEventAction(Game &game, const EventModel &event) {
+  return chooseBestAction(game, event.action_ids);
+}
+
+int32_t GreedyPolicy::chooseIssueAction(Game &game, const IssueModel &issue) {
+  return chooseBestAction(game, issue.actions);
+}
+
+void GreedyPolicy::shop(Game &game, const ActionModel &store) {
+  for (auto itemId : store.item_ids) {
+    if (Score(game.getItems().getItem(itemId).stat_delta) > 0) {
+      buyIfInStock(game, store, itemId);
+    }
+  }
+}
+
+double GreedyPolicy::Score(const StatModel &delta) {
+  // max_mph defaults to 1 so deltas can be used as stats, don't count it as a gain
+  return delta.health +
+         5.0 * (delta.max_mph - 1) -
+         0.1 * delta.kit_weight -
+         100.0 * (delta.odds_health_issue + delta.odds_mech_issue);
+}
+
+int32_t GreedyPolicy::chooseBestAction(Game &game, const std::vector<int32_t> &actionIds) {
+  if (actionIds.empty()) { return -1; }
+  auto bestId = actionIds.front();
+  auto bestScore = -INFINITY;
+  for (auto id : actionIds) {
+    if (!game.getActions().isVisible(id)) { continue; }
+    auto score = expectedScore(game.getActions().getAction(id));
+    if (score > bestScore) {
+      bestId = id;
+      bestScore = score;
+    }
+  }
+  return bestId;
+}
+
+ScriptedPolicy::ScriptedPolicy(std::unordered_map<int32_t, int32_t> eventChoices,
+                               std::unordered_map<int32_t, int32_t> issueChoices,
+                               std::vector<int32_t> itemsToBuy)
+: m_eventChoices(std::move(eventChoices))
+, m_issueChoices(std::move(issueChoices))
+, m_itemsToBuy(std::move(itemsToBuy)) {}
+
+int32_t ScriptedPolicy::chooseEventAction(Game &, const EventModel &event) {
+  auto choice = m_eventChoices.find(event.id);
+  if (choice != m_eventChoices.end()) { return choice->second; }
+  return event.action_ids.empty() ? -1 : event.action_ids.front();
+}
+
+int32_t ScriptedPolicy::chooseIssueAction(Game &, const IssueModel &issue) {
+  auto choice = m_issueChoices.find(issue.id);
+  if (choice != m_issueChoices.end()) { return choice->second; }
+  return issue.actions.empty() ? -1 : issue.actions.front();
+}
+
+void ScriptedPolicy::shop(Game &game, const ActionModel &store) {
+  for (auto itemId : m_itemsToBuy) {
+    buyIfInStock(game, store, itemId);
+  }
+}
+
+void Histogram::add(int64_t value) {
+  counts[value]++;
+  total++;
+}
+
+void Histogram::merge(const Histogram &rhs) {
+  for (const auto &[value, count] : rhs.counts) {
+    counts[value] += count;
+  }
+  total += rhs.total;
+}
+
+double Histogram::mean() const {
+  if (total == 0) { return 0; }
+  double sum = 0;
+  for (const auto &[value, count] : counts) {
+    sum += static_cast<double>(value) * count;
+  }
+  return sum / total;
+}
+
+int64_t Histogram::percentile(double p) const {
+  if (total == 0) { return 0; }
+  auto rank = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * total));
+  uint64_t seen = 0;
+  for (const auto &[value, count] : counts) {
+    seen += count;
+    if (seen >= std::max<uint64_t>(rank, 1)) { return value; }
+  }
+  return counts.rbegin()->first;
+}
+
+void Report::add(const Playthrough &playthrough) {
+  playthroughs++;
+  completed += playthrough.completed;
+  survived += playthrough.survived;
+  ending_ids.add(playthrough.ending_id);
+  issues_hit.add(playthrough.issues_hit);
+  miles_reached.add(playthrough.mile_reached);
+  money_spent.add(playthrough.money_spent);
+}
+
+void Report::merge(const Report &rhs) {
+  playthroughs += rhs.playthroughs;
+  completed += rhs.completed;
+  survived += rhs.survived;
+  ending_ids.merge(rhs.ending_ids);
+  issues_hit.merge(rhs.issues_hit);
+  miles_reached.merge(rhs.miles_reached);
+  money_spent.merge(rhs.money_spent);
+}
+
+double Report::survivalRate() const {
+  return playthroughs ? static_cast<double>(survived) / playthroughs : 0;
+}
+
+Playthrough sim::Simulate(Game &game, IDecisionPolicy &policy, uint32_t maxTicks) {
+  auto observer = std::make_shared<PolicyObserver>(game, policy);
+  game.registerEventObserver(observer);
+  auto startingMoney = game.getStats().getPlayerStatsModel().money_remaining;
+
+  // Nothing ever waits on the clock, the engine is driven directly from this thread
+  Engine engine(game, std::make_shared<UnthrottledPacing>());
+  auto status = Engine::Status::RUNNING;
+  while (status == Engine::Status::RUNNING && engine.getCurrentTick() < maxTicks) {
+    status = engine.advance();
+  }
+  if (status == Engine::Status::AWAITING_INPUT) {
+    spdlog::warn("Simulated game is waiting on a decision the policy didn't make");
+  }
+
+  Playthrough result;
+  result.final_stats = game.getStats().getPlayerStatsModel();
+  result.completed = status == Engine::Status::GAME_OVER;
+  result.survived = result.completed && result.final_stats.health > 0;
+  result.ending_id = observer->endingId;
+  result.issues_hit = observer->issuesHit;
+  result.mile_reached = game.getCurrentMile();
+  result.money_spent = std::max(0, startingMoney - result.final_stats.money_remaining);
+  result.ticks = engine.getCurrentTick();
+  return result;
+}
+
+uint64_t sim::PlaythroughSeed(uint64_t seed, uint64_t index) {
+  // splitmix64 so neighbouring indices get unrelated seeds
+  uint64_t z = seed + (index + 1) * 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27u)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31u);
+}
+
+Report sim::Run(const Options &options) {
+  auto makeGame = options.make_game ? options.make_game : [](uint64_t seed) {
+    return std::make_unique<Game>("simulation", seed);
+  };
+  auto makePolicy = options.make_policy ? options.make_policy : [](uint64_t seed) {
+    return std::unique_ptr<IDecisionPolicy>(std::make_unique<RandomPolicy>(seed));
+  };
+
+  auto threadCount = options.threads ? options.threads : std::thread::hardware_concurrency();
+  threadCount = static_cast<uint32_t>(std::clamp<uint64_t>(threadCount, 1, std::max<uint64_t>(options.playthroughs, 1)));
+
+  // Each thread keeps its own report so the only shared state is the counter
+  std::atomic<uint64_t> nextPlaythrough(0);
+  std::vector<Report> reports(threadCount);
+  auto worker = [&](Report &report) {
+    while (true) {
+      auto first = nextPlaythrough.fetch_add(kPlaythroughsPerChunk);
+      if (first >= options.playthroughs) { return; }
+      auto last = std::min(first + kPlaythroughsPerChunk, options.playthroughs);
+      for (auto i = first; i < last; i++) {
+        auto seed = PlaythroughSeed(options.seed, i);
+        auto game = makeGame(seed);
+        auto policy = makePolicy(seed);
+        auto journal = options.on_journal ? std::make_shared<Journal>() : nullptr;
+        game->recordTo(journal);
+        report.add(Simulate(*game, *policy, options.max_ticks));
+        if (journal) { options.on_journal(i, *journal); }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < threadCount; i++) {
+    threads.emplace_back(worker, std::ref(reports[i]));
+  }
+  worker(reports[0]);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  Report total;
+  for (const auto &report : reports) {
+    total.merge(report);
+  }
+  return total;
+}
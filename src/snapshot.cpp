@@ -0,0 +1,257 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/snapshot.hpp>
+
+// System includes
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <unordered_set>
+
+// 3P Includes
+#include <spdlog/spdlog.h>
+
+// Local includes
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/stat_model.hpp>
+
+using namespace libgtfoklahoma;
+
+namespace {
+const char kMagic[4] = {'G', 'T', 'F', 'S'};
+const uint32_t kByteOrderMark = 0x01020304;
+
+// A bitset is only used while it's no bigger than listing the ids out
+const int64_t kMaxBitsPerId = 32;
+const int64_t kMinBits = 64;
+
+// Happened ids, either as bits from the smallest id up or as a sorted list
+struct IdSection {
+  int32_t base;       // Bitsets only
+  uint32_t words;     // Bitset words that follow
+  uint32_t listed;    // Listed ids that follow, no bitset if any
+};
+
+struct Header {
+  char magic[4];
+  uint16_t version;
+  uint16_t stat_model_size;
+  uint32_t byte_order;
+  uint32_t total_size;
+  uint64_t seed;
+  uint64_t content_hash;
+  Rng::State action_rng;
+  Rng::State issue_rng;
+  StatModel stats;
+  int32_t current_hour;
+  int32_t current_mile;
+  uint32_t inventory_count;
+  uint32_t ending_hint_count;
+  IdSection happened_actions;
+  IdSection happened_issues;
+};
+static_assert(std::is_trivially_copyable<StatModel>::value, "StatModel is copied into snapshots as-is");
+static_assert(std::is_trivially_copyable<Header>::value, "Snapshot headers are copied as-is");
+
+struct InventoryEntry {
+  int32_t id;
+  int32_t quantity;
+};
+
+struct EncodedIds {
+  std::vector<uint64_t> bits;
+  std::vector<int32_t> list;
+
+  [[nodiscard]] size_t byteSize() const {
+    return bits.size() * sizeof(uint64_t) + list.size() * sizeof(int32_t);
+  }
+};
+
+// Ids are usually sparse but clustered, so store them as bits from the
+// smallest id up. Ids spread too far apart for that are listed instead.
+template<typename Set>
+EncodedIds encodeIds(const Set &ids, IdSection &section) {
+  EncodedIds encoded;
+  section = IdSection{0, 0, 0};
+  if (ids.empty()) { return encoded; }
+
+  auto [min, max] = std::minmax_element(ids.begin(), ids.end());
+  auto span = static_cast<int64_t>(*max) - *min + 1;
+  if (span > kMaxBitsPerId * static_cast<int64_t>(ids.size()) + kMinBits) {
+    encoded.list.assign(ids.begin(), ids.end());
+    std::sort(encoded.list.begin(), encoded.list.end());
+    section.listed = encoded.list.size();
+    return encoded;
+  }
+
+  section.base = *min;
+  encoded.bits.resize((span - 1) / 64 + 1);
+  for (auto id : ids) {
+    auto offset = static_cast<uint64_t>(static_cast<int64_t>(id) - section.base);
+    encoded.bits[offset / 64] |= uint64_t(1) << (offset % 64);
+  }
+  section.words = encoded.bits.size();
+  return encoded;
+}
+
+uint64_t sectionSize(const IdSection &section) {
+  return uint64_t(section.words) * sizeof(uint64_t) + uint64_t(section.listed) * sizeof(int32_t);
+}
+
+std::unordered_set<int32_t> decodeIds(const uint8_t *data, const IdSection &section) {
+  std::unordered_set<int32_t> ids;
+  for (uint32_t i = 0; i < section.listed; i++) {
+    int32_t id;
+    std::memcpy(&id, data + i * sizeof(id), sizeof(id));
+    ids.insert(id);
+  }
+  for (uint32_t i = 0; i < section.words; i++) {
+    uint64_t word;
+    std::memcpy(&word, data + i * sizeof(word), sizeof(word));
+    for (uint32_t bit = 0; word; bit++, word >>= 1u) {
+      if (word & 1u) { ids.insert(static_cast<int32_t>(section.base + static_cast<int64_t>(i) * 64 + bit)); }
+    }
+  }
+  return ids;
+}
+
+template<typename T>
+uint8_t *copyOut(uint8_t *dest, const T *src, size_t count) {
+  if (count) { std::memcpy(dest, src, count * sizeof(T)); }
+  return dest + count * sizeof(T);
+}
+
+bool readHeader(const uint8_t *data, size_t size, Header &header) {
+  if (size < sizeof(Header)) { return false; }
+  std::memcpy(&header, data, sizeof(Header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    spdlog::warn("Not a snapshot");
+    return false;
+  }
+  if (header.version != snapshot::kVersion ||
+      header.stat_model_size != sizeof(StatModel) ||
+      header.byte_order != kByteOrderMark) {
+    spdlog::warn("Snapshot version {} was written by an incompatible host", header.version);
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+void snapshot::Write(Game &game, std::vector<uint8_t> &out) {
+  // The inventory is kept sorted by id already
+  const auto &inventory = game.getInventoryCounts();
+  auto endingHints = game.getEndingHintIds();
+
+  // Zeroed so padding doesn't leak whatever was on the stack
+  Header header;
+  std::memset(static_cast<void *>(&header), 0, sizeof(header));
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.stat_model_size = sizeof(StatModel);
+  header.byte_order = kByteOrderMark;
+  header.seed = game.getSeed();
+  header.content_hash = game.getContentHash();
+  header.action_rng = game.getActionRng().getState();
+  header.issue_rng = game.getIssueRng().getState();
+  header.stats = game.getStats().getPlayerStatsModel();
+  header.current_hour = game.getCurrentHour();
+  header.current_mile = game.getCurrentMile();
+  header.inventory_count = inventory.size();
+  header.ending_hint_count = endingHints.size();
+
+  auto actionIds = encodeIds(game.getActions().getActionsThatHaveAlreadyHappened(), header.happened_actions);
+  auto issueIds = encodeIds(game.getIssues().getIssuesThatHaveAlreadyHappened(), header.happened_issues);
+
+  header.total_size = sizeof(Header) +
+                      inventory.size() * sizeof(InventoryEntry) +
+                      endingHints.size() * sizeof(int32_t) +
+                      actionIds.byteSize() + issueIds.byteSize();
+
+  auto start = out.size();
+  out.resize(start + header.total_size);
+  auto *cursor = copyOut(out.data() + start, &header, 1);
+  for (const auto &[id, quantity] : inventory) {
+    InventoryEntry entry{id, quantity};
+    cursor = copyOut(cursor, &entry, 1);
+  }
+  cursor = copyOut(cursor, endingHints.data(), endingHints.size());
+  for (const auto *ids : {&actionIds, &issueIds}) {
+    cursor = copyOut(cursor, ids->list.data(), ids->list.size());
+    cursor = copyOut(cursor, ids->bits.data(), ids->bits.size());
+  }
+}
+
+std::vector<uint8_t> snapshot::Write(Game &game) {
+  std::vector<uint8_t> out;
+  Write(game, out);
+  return out;
+}
+
+std::optional<uint64_t> snapshot::ReadSeed(const uint8_t *data, size_t size) {
+  Header header;
+  if (!readHeader(data, size, header)) { return std::nullopt; }
+  return header.seed;
+}
+
+bool snapshot::Read(const uint8_t *data, size_t size, Game &game) {
+  Header header;
+  if (!readHeader(data, size, header)) { return false; }
+
+  uint64_t expectedSize = sizeof(Header) +
+                          uint64_t(header.inventory_count) * sizeof(InventoryEntry) +
+                          uint64_t(header.ending_hint_count) * sizeof(int32_t) +
+                          sectionSize(header.happened_actions) +
+                          sectionSize(header.happened_issues);
+  const bool sectionsAreValid = !(header.happened_actions.words && header.happened_actions.listed) &&
+                                !(header.happened_issues.words && header.happened_issues.listed);
+  if (!sectionsAreValid || header.total_size != expectedSize || size < expectedSize) {
+    spdlog::warn("Truncated snapshot");
+    return false;
+  }
+  if (header.seed != game.getSeed() || header.content_hash != game.getContentHash()) {
+    spdlog::warn("Snapshot was taken with a different seed or different content");
+    return false;
+  }
+
+  game.getActionRng().setState(header.action_rng);
+  game.getIssueRng().setState(header.issue_rng);
+  game.getStats().setPlayerStatsModel(header.stats);
+  game.setCurrentHour(header.current_hour);
+  game.setCurrentMile(header.current_mile);
+
+  const auto *cursor = data + sizeof(Header);
+  Inventory inventory;
+  for (uint32_t i = 0; i < header.inventory_count; i++) {
+    InventoryEntry entry;
+    std::memcpy(&entry, cursor, sizeof(entry));
+    cursor += sizeof(entry);
+    inventory.add(entry.id, entry.quantity);
+  }
+  game.setInventoryCounts(std::move(inventory));
+
+  std::vector<int32_t> endingHints(header.ending_hint_count);
+  if (!endingHints.empty()) { std::memcpy(endingHints.data(), cursor, endingHints.size() * sizeof(int32_t)); }
+  cursor += endingHints.size() * sizeof(int32_t);
+  game.setEndingHintIds(endingHints);
+
+  game.getActions().setActionsThatHaveAlreadyHappened(decodeIds(cursor, header.happened_actions));
+  cursor += sectionSize(header.happened_actions);
+  game.getIssues().setIssuesThatHaveAlreadyHappened(decodeIds(cursor, header.happened_issues));
+  return true;
+}
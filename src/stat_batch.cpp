@@ -0,0 +1,132 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libgtfoklahoma/stat_batch.hpp>
+
+#include <spdlog/spdlog.h>
+
+using namespace libgtfoklahoma;
+
+namespace {
+// Raw pointers so the compiler knows the column can't alias the mask and
+// turns these into packed adds
+template<typename T>
+void addColumn(std::vector<T> &column, T delta) {
+  if (delta == 0) { return; }
+  T *values = column.data();
+  const size_t count = column.size();
+  for (size_t i = 0; i < count; ++i) {
+    values[i] += delta;
+  }
+}
+
+// Branch-free so the masked case vectorizes too: unflagged riders add 0
+template<typename T>
+void addColumn(std::vector<T> &column, T delta, const uint8_t *mask) {
+  if (delta == 0) { return; }
+  T *values = column.data();
+  const size_t count = column.size();
+  for (size_t i = 0; i < count; ++i) {
+    values[i] += delta * static_cast<T>(mask[i]);
+  }
+}
+} // namespace
+
+void StatBatch::reserve(size_t riders) {
+  bedtime_hour.reserve(riders);
+  health.reserve(riders);
+  kit_weight.reserve(riders);
+  max_mph.reserve(riders);
+  money_remaining.reserve(riders);
+  odds_health_issue.reserve(riders);
+  odds_mech_issue.reserve(riders);
+  pace.reserve(riders);
+  wakeup_hour.reserve(riders);
+}
+
+void StatBatch::push_back(const StatModel &stats) {
+  bedtime_hour.push_back(stats.bedtime_hour);
+  health.push_back(stats.health);
+  kit_weight.push_back(stats.kit_weight);
+  max_mph.push_back(stats.max_mph);
+  money_remaining.push_back(stats.money_remaining);
+  odds_health_issue.push_back(stats.odds_health_issue);
+  odds_mech_issue.push_back(stats.odds_mech_issue);
+  pace.push_back(stats.pace);
+  wakeup_hour.push_back(stats.wakeup_hour);
+}
+
+StatModel StatBatch::get(size_t rider) const {
+  return StatModel(bedtime_hour[rider],
+                   health[rider],
+                   kit_weight[rider],
+                   max_mph[rider],
+                   money_remaining[rider],
+                   odds_health_issue[rider],
+                   odds_mech_issue[rider],
+                   pace[rider],
+                   wakeup_hour[rider]);
+}
+
+void StatBatch::set(size_t rider, const StatModel &stats) {
+  bedtime_hour[rider] = stats.bedtime_hour;
+  health[rider] = stats.health;
+  kit_weight[rider] = stats.kit_weight;
+  max_mph[rider] = stats.max_mph;
+  money_remaining[rider] = stats.money_remaining;
+  odds_health_issue[rider] = stats.odds_health_issue;
+  odds_mech_issue[rider] = stats.odds_mech_issue;
+  pace[rider] = stats.pace;
+  wakeup_hour[rider] = stats.wakeup_hour;
+}
+
+void StatBatch::add(const StatModel &delta) {
+  addColumn(bedtime_hour, delta.bedtime_hour);
+  addColumn(health, delta.health);
+  addColumn(kit_weight, delta.kit_weight);
+  addColumn(max_mph, delta.max_mph);
+  addColumn(money_remaining, delta.money_remaining);
+  addColumn(wakeup_hour, delta.wakeup_hour);
+  addColumn(odds_health_issue, delta.odds_health_issue);
+  addColumn(odds_mech_issue, delta.odds_mech_issue);
+  if (delta.pace != StatModel::Pace::INVALID) {
+    pace.assign(pace.size(), delta.pace);
+  }
+}
+
+void StatBatch::add(const StatModel &delta, const std::vector<uint8_t> &riders) {
+  if (riders.size() != size()) {
+    spdlog::error("Got {} rider flags for {} riders", riders.size(), size());
+    return;
+  }
+
+  const uint8_t *mask = riders.data();
+  addColumn(bedtime_hour, delta.bedtime_hour, mask);
+  addColumn(health, delta.health, mask);
+  addColumn(kit_weight, delta.kit_weight, mask);
+  addColumn(max_mph, delta.max_mph, mask);
+  addColumn(money_remaining, delta.money_remaining, mask);
+  addColumn(wakeup_hour, delta.wakeup_hour, mask);
+  addColumn(odds_health_issue, delta.odds_health_issue, mask);
+  addColumn(odds_mech_issue, delta.odds_mech_issue, mask);
+  if (delta.pace != StatModel::Pace::INVALID) {
+    StatModel::Pace *paces = pace.data();
+    for (size_t i = 0; i < pace.size(); ++i) {
+      paces[i] = mask[i] ? delta.pace : paces[i];
+    }
+  }
+}
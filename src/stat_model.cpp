@@ -33,10 +33,10 @@ StatModel::StatModel(int32_t bedtimeHour,
 , kit_weight(kitWeight)
 , max_mph(maxMph)
 , money_remaining(moneyRemaining)
-, odds_health_issue(oddsHealthIssue)
-, odds_mech_issue(oddsMechIssue)
+, wakeup_hour(wakeupHour)
 , pace(pace)
-, wakeup_hour(wakeupHour) {}
+, odds_health_issue(oddsHealthIssue)
+, odds_mech_issue(oddsMechIssue) {}
 
 bool StatModel::operator==(const StatModel &rhs) const {
   return this->bedtime_hour == rhs.bedtime_hour &&
@@ -50,15 +50,38 @@ bool StatModel::operator==(const StatModel &rhs) const {
          this->wakeup_hour == rhs.wakeup_hour;
 }
 
-StatModel StatModel::operator+(const StatModel &rhs) {
+StatModel &StatModel::operator+=(const StatModel &rhs) {
+  // Field order matches the layout, which gives the optimizer contiguous runs
+  // of ints and doubles to work with
   this->bedtime_hour += rhs.bedtime_hour;
   this->health += rhs.health;
   this->kit_weight += rhs.kit_weight;
   this->max_mph += rhs.max_mph;
   this->money_remaining += rhs.money_remaining;
+  this->wakeup_hour += rhs.wakeup_hour;
+  if (rhs.pace != Pace::INVALID) { this->pace = rhs.pace; }
   this->odds_health_issue += rhs.odds_health_issue;
   this->odds_mech_issue += rhs.odds_mech_issue;
-  if (rhs.pace != Pace::INVALID) { this->pace = rhs.pace; }
-  this->wakeup_hour += rhs.wakeup_hour;
   return *this;
-}
\ No newline at end of file
+}
+
+StatModel StatModel::operator+(const StatModel &rhs) const {
+  StatModel result(*this);
+  result += rhs;
+  return result;
+}
+
+StatModel StatModel::operator*(int32_t times) const {
+  StatModel result(*this);
+  result.bedtime_hour *= times;
+  result.health *= times;
+  result.kit_weight *= times;
+  result.max_mph *= times;
+  result.money_remaining *= times;
+  result.wakeup_hour *= times;
+  // Adding a pace change no times over doesn't change the pace
+  if (!times) { result.pace = Pace::INVALID; }
+  result.odds_health_issue *= times;
+  result.odds_mech_issue *= times;
+  return result;
+}
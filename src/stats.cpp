@@ -34,6 +34,7 @@ const StatModel &Stats::getPlayerStatsModel() const { return m_playerStats; }
 
 void Stats::setPlayerStatsModel(StatModel model) {
     m_playerStats = std::move(model);
+    m_game.publishPlayerState();
 }
 
 StatModel Stats::FromJson(const rapidjson::GenericArray<true, rapidjson::Value> &statChangesArray) {
@@ -17,9 +17,14 @@
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
+#include <ctime>
+#include <memory>
 #include <mutex>
+#include <thread>
 
+#include <libgtfoklahoma/clock.hpp>
 #include <libgtfoklahoma/event_observer.hpp>
 
 namespace testhelpers {
@@ -92,12 +97,26 @@ public:
   void onGameOver(const libgtfoklahoma::EndingModel &ending) override {}
   void onHourChanged(int32_t hour) override {}
   void onMileChanged(int32_t mile) override {}
-  bool onEvent(libgtfoklahoma::EventModel &event) override { return false; }
-  bool onIssueOccurred(libgtfoklahoma::IssueModel &issue) override { return false; }
+  bool onEvent(const libgtfoklahoma::EventModel &event) override { return false; }
+  bool onIssueOccurred(const libgtfoklahoma::IssueModel &issue) override { return false; }
   void onStatsChanged(const libgtfoklahoma::StatModel &stats) override {}
-  bool onStoreEntered(libgtfoklahoma::ActionModel &action) override { return false; }
+  bool onStoreEntered(const libgtfoklahoma::ActionModel &action) override { return false; }
 };
 
+// Keeps real-time pacing without the test actually waiting on it
+inline std::shared_ptr<libgtfoklahoma::IClock> fastForwardClock() {
+  return std::make_shared<libgtfoklahoma::VirtualClock>(
+      libgtfoklahoma::VirtualClock::Mode::ADVANCE_WHEN_WAITING);
+}
+
+// CPU time the whole process burns while the calling thread sleeps through
+// `duration`, for catching threads that busy-wait instead of blocking
+inline std::chrono::milliseconds cpuTimeWhileSleeping(std::chrono::milliseconds duration) {
+  const auto start = std::clock();
+  std::this_thread::sleep_for(duration);
+  return std::chrono::milliseconds((std::clock() - start) * 1000 / CLOCKS_PER_SEC);
+}
+
 class EngineStopper {
 public:
   EngineStopper()
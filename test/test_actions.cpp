@@ -73,12 +73,12 @@ TEST_CASE("Actions", "[unit]") {
   SECTION("Action::getAction") {
     {
       auto &action = actions.getAction(0);
-      REQUIRE_FALSE(action == actions.kEmptyActionModel);
+      REQUIRE_FALSE(action == ContentCatalog::kEmptyActionModel);
     }
 
     {
       auto &action = actions.getAction(-1);
-      REQUIRE(action == actions.kEmptyActionModel);
+      REQUIRE(action == ContentCatalog::kEmptyActionModel);
     }
   }
 
@@ -94,18 +94,18 @@ TEST_CASE("Actions", "[unit]") {
       REQUIRE(actions.actionHasHappened(0));
   }
 
-  SECTION("ActionModel::purchaseItem") {
-      REQUIRE(actions.getAction(0).purchaseItem(0));
-      actions.getAction(0).completePurchase();
-      actions.getAction(0).purchaseComplete().get();
+  SECTION("Actions::purchaseItem") {
+      REQUIRE(actions.purchaseItem(0, 0));
+      actions.completePurchase(0);
+      REQUIRE(actions.purchaseComplete(0).get());
       auto purchasedItems = game.getInventory();
 
       REQUIRE(purchasedItems.size());
-      REQUIRE(purchasedItems[0].get().id == 0);
+      REQUIRE((*purchasedItems.begin()).item.id == 0);
   }
 
   SECTION("ActionModel::is*type") {
-    ActionModel &model = actions.getAction(2);
+    const ActionModel &model = actions.getAction(2);
 
     REQUIRE_FALSE(model.isNoneType());
     REQUIRE(model.isStatChangeType());
@@ -166,8 +166,8 @@ TEST_CASE("Actions - Ending hints") {
       TestActionEndingHints::running = false;
       TestActionEndingHints::simulation.notify_one();
     }
-    bool onEvent(EventModel &event) override {
-      event.chooseAction(0);
+    bool onEvent(const EventModel &event) override {
+      m_game.getEvents().chooseAction(event.id, 0);
       return true;
     }
   };
@@ -175,7 +175,7 @@ TEST_CASE("Actions - Ending hints") {
   auto observer = std::make_unique<NonsenseObserver>(game);
   game.registerEventObserver(std::move(observer));
 
-  Engine engine(game);
+  Engine engine(game, std::make_shared<RealTimePacing>(), fastForwardClock());
   engine.start();
 
   std::unique_lock<std::mutex> lock(TestActionEndingHints::mutex);
@@ -229,16 +229,16 @@ TEST_CASE("Actions - Store Type Actions") {
     auto initial_money = game.getStats().getPlayerStatsModel().money_remaining;
 
     // Tell the mock to purchase the item
-    When(Method(mockObserver, onStoreEntered)).AlwaysDo([](ActionModel &action){
-      auto UNUSED = action.purchaseItem(0);
-      action.completePurchase();
+    When(Method(mockObserver, onStoreEntered)).AlwaysDo([&game](const ActionModel &action){
+      auto UNUSED = game.getActions().purchaseItem(action.id, 0);
+      game.getActions().completePurchase(action.id);
       return true;
     });
 
     game.getActions().handleAction(0, mockObserverPtr);
     auto inventory = game.getInventory();
     REQUIRE(inventory.size() == 1);
-    REQUIRE(inventory[0].get().id == 0);
+    REQUIRE((*inventory.begin()).item.id == 0);
     auto current_money = game.getStats().getPlayerStatsModel().money_remaining;
     REQUIRE(current_money == initial_money - 1);
   }
@@ -259,8 +259,7 @@ TEST_CASE("Actions - Success/Failure") {
     ]
     )";
     Game game("", actionsJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
-    auto &action = game.getActions().getAction(0);
-    REQUIRE(action.failed());
+    REQUIRE(game.getActions().actionFailed(0));
   }
 }
 
@@ -279,13 +278,13 @@ TEST_CASE("Actions - inventory dependent") {
   )";
   Game game("", actionsJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
 
-  SECTION("ActionModel::isVisible - negative case") {
-    REQUIRE_FALSE(game.getActions().getAction(0).isVisible());
+  SECTION("Actions::isVisible - negative case") {
+    REQUIRE_FALSE(game.getActions().isVisible(0));
   }
 
-  SECTION("ActionModel::isVisible - positive case") {
+  SECTION("Actions::isVisible - positive case") {
     game.addItemToInventory(0, 1);
-    REQUIRE(game.getActions().getAction(0).isVisible());
+    REQUIRE(game.getActions().isVisible(0));
   }
 }
 
@@ -0,0 +1,82 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <libgtfoklahoma/bitset.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("Bitset", "[unit]") {
+
+  SECTION("Bitset::set") {
+    Bitset bits(130);
+    REQUIRE(bits.size() == 130);
+    REQUIRE(bits.count() == 0);
+
+    bits.set(0);
+    bits.set(64);
+    bits.set(129);
+    bits.set(130); // Out of range, ignored
+    REQUIRE(bits.test(0));
+    REQUIRE(bits.test(64));
+    REQUIRE(bits.test(129));
+    REQUIRE_FALSE(bits.test(130));
+    REQUIRE(bits.count() == 3);
+
+    bits.set(64, false);
+    REQUIRE_FALSE(bits.test(64));
+    REQUIRE(bits.count() == 2);
+
+    bits.reset();
+    REQUIRE(bits.count() == 0);
+  }
+
+  SECTION("Bitset::containsAll") {
+    Bitset bits(100);
+    Bitset mask(100);
+    REQUIRE(bits.containsAll(mask));
+
+    mask.set(3);
+    mask.set(70);
+    REQUIRE_FALSE(bits.containsAll(mask));
+    bits.set(3);
+    REQUIRE_FALSE(bits.containsAll(mask));
+    bits.set(70);
+    bits.set(99);
+    REQUIRE(bits.containsAll(mask));
+
+    // A shorter set is missing whatever the mask has past its end
+    Bitset shorter(10);
+    shorter.set(3);
+    REQUIRE_FALSE(shorter.containsAll(mask));
+  }
+
+  SECTION("Bitset::findNth") {
+    Bitset bits(200);
+    bits.set(5);
+    bits.set(63);
+    bits.set(64);
+    bits.set(190);
+
+    REQUIRE(bits.findNth(0) == 5);
+    REQUIRE(bits.findNth(1) == 63);
+    REQUIRE(bits.findNth(2) == 64);
+    REQUIRE(bits.findNth(3) == 190);
+    REQUIRE(bits.findNth(4) == bits.size());
+  }
+}
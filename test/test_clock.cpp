@@ -0,0 +1,100 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+#include <libgtfoklahoma/clock.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("Clock", "[unit]") {
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  bool stopped = false;
+  auto stop = [&stopped]() { return stopped; };
+
+  SECTION("SteadyClock") {
+    SteadyClock clock;
+    const auto before = clock.now();
+    std::unique_lock<std::mutex> lock(mutex);
+    REQUIRE_FALSE(clock.waitUntil(lock, wakeup, before, stop));
+    REQUIRE(clock.now() >= before);
+  }
+
+  SECTION("VirtualClock::advance") {
+    const auto start = IClock::TimePoint(std::chrono::seconds(5));
+    VirtualClock clock(VirtualClock::Mode::MANUAL, start);
+    REQUIRE(clock.now() == start);
+
+    clock.advance(std::chrono::milliseconds(16));
+    REQUIRE(clock.now() == start + std::chrono::milliseconds(16));
+
+    // Never goes backwards
+    clock.advanceTo(start);
+    REQUIRE(clock.now() == start + std::chrono::milliseconds(16));
+  }
+
+  SECTION("VirtualClock::waitUntil - manual") {
+    VirtualClock clock;
+    const auto deadline = clock.now() + std::chrono::seconds(1);
+
+    std::thread waiter([&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      clock.waitUntil(lock, wakeup, deadline, stop);
+    });
+
+    while (!clock.waiterCount()) { std::this_thread::yield(); }
+    clock.advance(std::chrono::milliseconds(500));
+    REQUIRE(clock.waiterCount() == 1);
+    clock.advance(std::chrono::milliseconds(500));
+    waiter.join();
+    REQUIRE(clock.waiterCount() == 0);
+    REQUIRE(clock.now() == deadline);
+  }
+
+  SECTION("VirtualClock::waitUntil - stopped") {
+    VirtualClock clock;
+    bool result = false;
+
+    std::thread waiter([&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      result = clock.waitUntil(lock, wakeup, clock.now() + std::chrono::hours(1), stop);
+    });
+
+    while (!clock.waiterCount()) { std::this_thread::yield(); }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopped = true;
+    }
+    wakeup.notify_all();
+    waiter.join();
+    REQUIRE(result);
+    REQUIRE(clock.now() == IClock::TimePoint());
+  }
+
+  SECTION("VirtualClock::waitUntil - advance when waiting") {
+    VirtualClock clock(VirtualClock::Mode::ADVANCE_WHEN_WAITING);
+    const auto deadline = clock.now() + std::chrono::hours(1);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    REQUIRE_FALSE(clock.waitUntil(lock, wakeup, deadline, stop));
+    REQUIRE(clock.now() == deadline);
+    REQUIRE(lock.owns_lock());
+  }
+}
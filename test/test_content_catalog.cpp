@@ -0,0 +1,87 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <libgtfoklahoma/content_catalog.hpp>
+#include <libgtfoklahoma/content_pack.hpp>
+#include <libgtfoklahoma/game.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("ContentCatalog") {
+  auto pack = ContentPack::LoadDirectory(LIBGTFOKLAHOMA_DATA_DIR);
+  REQUIRE(pack);
+  auto catalog = ContentCatalog::FromPack(*pack);
+
+  SECTION("ContentCatalog::get*") {
+    REQUIRE(catalog->getContentHash() == pack->getContentHash());
+    REQUIRE(catalog->getEvent(0).display_name == "Frampton Inn - Miami, OK");
+    REQUIRE(catalog->getAction(10).isStoreType());
+    REQUIRE(catalog->getItem(0).cost == 1200);
+    REQUIRE(catalog->getEventIdsByMile().at(2) == std::vector<int32_t>{1});
+    REQUIRE(catalog->getIssueIds(IssueModel::Type::MECHANICAL) == std::vector<int32_t>{20});
+    REQUIRE(catalog->getIssueIds(IssueModel::Type::INVALID).empty());
+
+    REQUIRE(&catalog->getEvent(-1) == &ContentCatalog::kEmptyEventModel);
+    REQUIRE(&catalog->getAction(-1) == &ContentCatalog::kEmptyActionModel);
+  }
+
+  SECTION("ContentCatalog::getIssueDependencies") {
+    const auto &roastABone = catalog->getIssueDependencies(0);
+    REQUIRE(roastABone.satisfiable);
+    REQUIRE(roastABone.actions.count() == 0);
+    REQUIRE(roastABone.items.count() == 1);
+    REQUIRE(roastABone.items.test(catalog->getItemIndex(1)));
+
+    const auto &covid = catalog->getIssueDependencies(10);
+    REQUIRE(covid.satisfiable);
+    REQUIRE(covid.actions.count() == 1);
+    REQUIRE(covid.actions.test(catalog->getActionIndex(20)));
+
+    REQUIRE(catalog->getIssueIdsDependingOnAction(20) == std::vector<int32_t>{10});
+    REQUIRE(catalog->getIssueIdsDependingOnItem(1) == std::vector<int32_t>{0});
+    REQUIRE(catalog->getIssueIdsDependingOnItem(0).empty());
+
+    REQUIRE_FALSE(catalog->getIssueDependencies(-1).satisfiable);
+  }
+
+  SECTION("Games share one catalog") {
+    Game first("first", catalog);
+    Game second("second", catalog);
+    REQUIRE(first.getCatalog() == second.getCatalog());
+    REQUIRE(&first.getEvents().getEvent(0) == &second.getEvents().getEvent(0));
+    REQUIRE(first.getContentHash() == pack->getContentHash());
+
+    // So do games using the built-in content
+    Game third("third");
+    Game fourth("fourth");
+    REQUIRE(third.getCatalog() == fourth.getCatalog());
+  }
+
+  SECTION("Decisions belong to the game, not the catalog") {
+    Game first("first", catalog);
+    Game second("second", catalog);
+    REQUIRE(first.getEvents().chooseAction(1, 10));
+    REQUIRE(first.getEvents().chosenAction(1).isDecided());
+    REQUIRE_FALSE(second.getEvents().chosenAction(1).isDecided());
+
+    first.getActions().completePurchase(10);
+    REQUIRE(first.getActions().purchaseComplete(10).isDecided());
+    REQUIRE_FALSE(second.getActions().purchaseComplete(10).isDecided());
+  }
+}
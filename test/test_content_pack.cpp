@@ -0,0 +1,67 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <libgtfoklahoma/content_pack.hpp>
+
+using namespace libgtfoklahoma;
+
+namespace {
+void writeFile(const std::string &path, const std::string &contents) {
+  std::ofstream(path, std::ios::trunc) << contents;
+}
+}
+
+TEST_CASE("ContentPack") {
+  SECTION("data/ matches the built-in content") {
+    auto pack = ContentPack::LoadDirectory(LIBGTFOKLAHOMA_DATA_DIR);
+    REQUIRE(pack);
+
+    // The built-in content is generated from data/, byte for byte
+    REQUIRE(pack->getContentHash() == ContentPack::BuiltIn()->getContentHash());
+  }
+
+  SECTION("Missing and broken packs aren't loaded") {
+    REQUIRE_FALSE(ContentPack::LoadDirectory("/nonexistent"));
+
+    // Files that fill their last page exactly don't have a terminator of their own
+    char directory[] = "/tmp/gtfo_content_XXXXXX";
+    REQUIRE(mkdtemp(directory));
+    std::string dir = directory;
+    std::string pageSized = "[" + std::string(4096 - 2, ' ') + "]";
+    for (const auto *name : {"actions.json", "endings.json", "events.json", "issues.json", "items.json"}) {
+      writeFile(dir + "/" + name, pageSized);
+    }
+    auto pack = ContentPack::LoadDirectory(dir);
+    REQUIRE(pack);
+    REQUIRE(pack->getEvents().Size() == 0);
+
+    writeFile(dir + "/events.json", "[{");
+    REQUIRE_FALSE(ContentPack::LoadDirectory(dir));
+
+    for (const auto *name : {"actions.json", "endings.json", "events.json", "issues.json", "items.json"}) {
+      std::remove((dir + "/" + name).c_str());
+    }
+    std::remove(directory);
+  }
+}
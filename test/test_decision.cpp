@@ -0,0 +1,83 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+#include <libgtfoklahoma/decision.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("Decision", "[unit]") {
+  Decision<int32_t> decision;
+
+  SECTION("Decision::decide") {
+    REQUIRE_FALSE(decision.isDecided());
+    REQUIRE(decision.decide(10));
+    REQUIRE(decision.isDecided());
+    REQUIRE(decision.get() == 10);
+
+    // First decision sticks
+    REQUIRE_FALSE(decision.decide(20));
+    REQUIRE(decision.get() == 10);
+  }
+
+  SECTION("Decision::onDecided - before deciding") {
+    bool called = false;
+    decision.onDecided([&called]() { called = true; });
+    REQUIRE_FALSE(called);
+
+    std::thread([&decision]() { decision.decide(10); }).join();
+    REQUIRE(called);
+  }
+
+  SECTION("Decision::onDecided - after deciding") {
+    decision.decide(10);
+    bool called = false;
+    decision.onDecided([&called]() { called = true; });
+    REQUIRE(called);
+  }
+
+  SECTION("Decision::reset") {
+    decision.decide(10);
+    decision.reset();
+    REQUIRE_FALSE(decision.isDecided());
+    REQUIRE(decision.decide(20));
+    REQUIRE(decision.get() == 20);
+  }
+}
+
+TEST_CASE("DecisionTable", "[unit]") {
+  DecisionTable<int32_t> table;
+
+  SECTION("DecisionTable::get") {
+    REQUIRE(&table.get(1) == &table.get(1));
+    REQUIRE_FALSE(&table.get(1) == &table.get(2));
+    table.get(1).decide(10);
+    REQUIRE(table.get(1).get() == 10);
+    REQUIRE_FALSE(table.get(2).isDecided());
+  }
+
+  SECTION("DecisionTable::ask") {
+    table.get(1).decide(10);
+    auto &decision = table.ask(1);
+    REQUIRE(&decision == &table.get(1));
+    REQUIRE_FALSE(decision.isDecided());
+    REQUIRE(decision.decide(20));
+  }
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <libgtfoklahoma/dense_table.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("DenseTable", "[unit]") {
+  SECTION("DenseTable::find - dense ids") {
+    DenseTable<std::string> table({{2, "two"}, {3, "three"}, {5, "five"}});
+    REQUIRE(table.size() == 3);
+    REQUIRE(*table.find(2) == "two");
+    REQUIRE(*table.find(5) == "five");
+    REQUIRE_FALSE(table.find(4));
+    REQUIRE_FALSE(table.find(1));
+    REQUIRE_FALSE(table.find(6));
+    REQUIRE_FALSE(table.find(-1));
+    REQUIRE_FALSE(table.find(INT32_MIN));
+    REQUIRE_FALSE(table.find(INT32_MAX));
+  }
+
+  SECTION("DenseTable::find - sparse ids") {
+    DenseTable<std::string> table({{-7, "low"}, {0, "zero"}, {1000000000, "high"}});
+    REQUIRE(*table.find(-7) == "low");
+    REQUIRE(*table.find(0) == "zero");
+    REQUIRE(*table.find(1000000000) == "high");
+    REQUIRE_FALSE(table.find(1));
+  }
+
+  SECTION("DenseTable::find - empty") {
+    DenseTable<std::string> table;
+    REQUIRE(table.empty());
+    REQUIRE_FALSE(table.find(0));
+  }
+
+  SECTION("DenseTable::begin - id order") {
+    DenseTable<int32_t> table({{3, 30}, {1, 10}, {2, 20}});
+    std::vector<int32_t> values(table.begin(), table.end());
+    REQUIRE(values == std::vector<int32_t>{10, 20, 30});
+  }
+}
@@ -0,0 +1,373 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <future>
+
+#include "helpers.hpp"
+
+#include <libgtfoklahoma/engine.hpp>
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/pacing.hpp>
+#include <libgtfoklahoma/rules.hpp>
+
+using namespace libgtfoklahoma;
+using namespace testhelpers;
+
+TEST_CASE("Pacing", "[unit]") {
+  SECTION("RealTimePacing") {
+    RealTimePacing pacing;
+    REQUIRE(pacing.delayForTicks(1) == rules::kTickDelayMs);
+    REQUIRE(pacing.delayForTicks(rules::kTicksPerGameHour) ==
+            rules::kTickDelayMs * rules::kTicksPerGameHour);
+  }
+
+  SECTION("ScaledPacing") {
+    ScaledPacing twiceAsFast(2);
+    REQUIRE(twiceAsFast.delayForTicks(2) == rules::kTickDelayMs);
+
+    // Nonsense speeds fall back to real-time
+    ScaledPacing nonsense(-1);
+    REQUIRE(nonsense.delayForTicks(1) == rules::kTickDelayMs);
+  }
+
+  SECTION("UnthrottledPacing") {
+    UnthrottledPacing pacing;
+    REQUIRE(pacing.delayForTicks(rules::kTicksPerGameHour).count() == 0);
+  }
+}
+
+TEST_CASE("Engine - Unthrottled pacing") {
+  // At 1 mph this is 50 game hours, which would take minutes in real-time
+  const char *eventJson = R"(
+  [
+    {
+      "id": 0,
+      "actions": [0],
+      "description": "",
+      "display_name": "",
+      "mile": 0
+    },
+    {
+      "id": 1,
+      "actions": [0],
+      "description": "",
+      "display_name": "",
+      "mile": 50
+    }
+  ]
+  )";
+
+  class Observer : public TestObserver {
+  public:
+    explicit Observer(EngineStopper &stopper, Game &game) : TestObserver(game), stopper(stopper) {}
+    void onGameOver(const EndingModel &) override { stopper.stopEngine(); }
+  private:
+    EngineStopper &stopper;
+  };
+
+  Game game("", validActionJson, validEndingJson, eventJson, validIssueJson, validItemJson);
+  EngineStopper stopper;
+  game.registerEventObserver(std::make_shared<Observer>(stopper, game));
+
+  Engine engine(game, std::make_shared<UnthrottledPacing>());
+  engine.start();
+  stopper.waitForEngineToStopOrFail();
+  REQUIRE(game.getCurrentMile() == 50);
+}
+
+TEST_CASE("Engine - Idle ticks are skipped") {
+  // Counts how often the engine wakes up and how many ticks it advanced in total
+  class CountingPacing : public IPacingPolicy {
+  public:
+    std::chrono::nanoseconds delayForTicks(uint32_t ticks) const override {
+      wakeups++;
+      totalTicks += ticks;
+      return std::chrono::nanoseconds::zero();
+    }
+    mutable std::atomic<uint32_t> wakeups{0};
+    mutable std::atomic<uint32_t> totalTicks{0};
+  };
+
+  const char *eventJson = R"(
+  [
+    {
+      "id": 0,
+      "actions": [0],
+      "description": "",
+      "display_name": "",
+      "mile": 0
+    },
+    {
+      "id": 1,
+      "actions": [0],
+      "description": "",
+      "display_name": "",
+      "mile": 10
+    }
+  ]
+  )";
+
+  class Observer : public TestObserver {
+  public:
+    explicit Observer(EngineStopper &stopper, Game &game) : TestObserver(game), stopper(stopper) {}
+    void onGameOver(const EndingModel &) override { stopper.stopEngine(); }
+  private:
+    EngineStopper &stopper;
+  };
+
+  Game game("", validActionJson, validEndingJson, eventJson, validIssueJson, validItemJson);
+  EngineStopper stopper;
+  game.registerEventObserver(std::make_shared<Observer>(stopper, game));
+
+  auto pacing = std::make_shared<CountingPacing>();
+  {
+    Engine engine(game, pacing);
+    engine.start();
+    stopper.waitForEngineToStopOrFail();
+  }
+
+  // At 1 mph mile 10 is reached on tick 1200, plus the initial tick of delay
+  REQUIRE(game.getCurrentMile() == 10);
+  REQUIRE(pacing->totalTicks == 10 * rules::kTicksPerGameHour + 1);
+
+  // Roughly two wake ups per hour (the boundary, then the issue checks) rather than 120
+  REQUIRE(pacing->wakeups < 3 * 10 + 2);
+}
+
+TEST_CASE("Engine - Resumes once the player decides") {
+  // Signals the test instead of deciding
+  class SlowDeciderObserver : public TestObserver {
+  public:
+    explicit SlowDeciderObserver(EngineStopper &stopper, Game &game) : TestObserver(game), stopper(stopper) {}
+    void onGameOver(const EndingModel &) override { stopper.stopEngine(); }
+    bool onEvent(const EventModel &event) override {
+      eventOccurred.set_value(&event);
+      return true;
+    }
+    std::promise<const EventModel *> eventOccurred;
+  private:
+    EngineStopper &stopper;
+  };
+
+  Game game("", validActionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
+  EngineStopper stopper;
+  auto observer = std::make_shared<SlowDeciderObserver>(stopper, game);
+  game.registerEventObserver(observer);
+
+  Engine engine(game, std::make_shared<RealTimePacing>(), fastForwardClock());
+  engine.start();
+
+  auto event = observer->eventOccurred.get_future().get();
+  REQUIRE(event->id == 0);
+  REQUIRE(game.getEvents().chooseAction(event->id, 0));
+  stopper.waitForEngineToStopOrFail();
+}
+
+TEST_CASE("Engine - Blocks while paused even once the player decides") {
+  class SlowDeciderObserver : public TestObserver {
+  public:
+    explicit SlowDeciderObserver(EngineStopper &stopper, Game &game) : TestObserver(game), stopper(stopper) {}
+    void onGameOver(const EndingModel &) override { stopper.stopEngine(); }
+    bool onEvent(const EventModel &event) override {
+      eventOccurred.set_value(&event);
+      return true;
+    }
+    std::promise<const EventModel *> eventOccurred;
+  private:
+    EngineStopper &stopper;
+  };
+
+  Game game("", validActionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
+  EngineStopper stopper;
+  auto observer = std::make_shared<SlowDeciderObserver>(stopper, game);
+  game.registerEventObserver(observer);
+
+  Engine engine(game, std::make_shared<UnthrottledPacing>());
+  engine.start();
+
+  auto event = observer->eventOccurred.get_future().get();
+  REQUIRE(engine.submit(Command::Pause()));
+  REQUIRE(game.getEvents().chooseAction(event->id, 0));
+
+  // A spinning engine thread would burn about as much CPU as wall time
+  REQUIRE(cpuTimeWhileSleeping(std::chrono::milliseconds(200)) < std::chrono::milliseconds(100));
+
+  REQUIRE(engine.submit(Command::Resume()));
+  stopper.waitForEngineToStopOrFail();
+}
+
+TEST_CASE("Engine - Commands") {
+  // Leaves the decision to whoever submits the command
+  class CommandObserver : public TestObserver {
+  public:
+    explicit CommandObserver(Game &game) : TestObserver(game) {}
+    bool onEvent(const EventModel &) override { return true; }
+  };
+
+  Game game("", validActionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
+  game.registerEventObserver(std::make_shared<CommandObserver>(game));
+  Engine engine(game, std::make_shared<UnthrottledPacing>());
+  REQUIRE(engine.advance() == Engine::Status::AWAITING_INPUT);
+
+  SECTION("Engine::submit - choose an action") {
+    REQUIRE(engine.submit(Command::ChooseEventAction(0, 0)));
+    REQUIRE(engine.hasPendingCommands());
+    REQUIRE(engine.advance() != Engine::Status::AWAITING_INPUT);
+    REQUIRE_FALSE(engine.hasPendingCommands());
+    REQUIRE(game.getEvents().chosenAction(0).get() == 0);
+  }
+
+  SECTION("Engine::submit - pause and resume") {
+    REQUIRE(engine.submit(Command::Pause()));
+    REQUIRE(engine.advance() == Engine::Status::PAUSED);
+    REQUIRE(engine.getStatus() == Engine::Status::PAUSED);
+
+    // Still paused even though the player has decided
+    REQUIRE(game.getEvents().chooseAction(0, 0));
+    REQUIRE(engine.advance() == Engine::Status::PAUSED);
+
+    REQUIRE(engine.submit(Command::Resume()));
+    REQUIRE(engine.advance() != Engine::Status::AWAITING_INPUT);
+  }
+
+  SECTION("Engine::submit - quit") {
+    REQUIRE(engine.submit(Command::Quit()));
+    REQUIRE(engine.advance() == Engine::Status::GAME_OVER);
+    REQUIRE(engine.getStatus() == Engine::Status::GAME_OVER);
+  }
+
+  SECTION("Engine::runUntil - waits on the player") {
+    auto result = engine.runUntil(Engine::Until::BLOCKED);
+    REQUIRE(result.reason == Engine::StepResult::Reason::AWAITING_INPUT);
+    REQUIRE(result.ticks == 0);
+
+    REQUIRE(engine.submit(Command::Pause()));
+    result = engine.advanceTicks(10);
+    REQUIRE(result.reason == Engine::StepResult::Reason::PAUSED);
+    REQUIRE(result.ticks == 0);
+    REQUIRE(engine.advanceTicks(10).reason == Engine::StepResult::Reason::PAUSED);
+
+    REQUIRE(engine.submit(Command::Resume()));
+    REQUIRE(engine.submit(Command::ChooseEventAction(0, 0)));
+    // The only event was the last one
+    result = engine.runUntil(Engine::Until::BLOCKED);
+    REQUIRE(result.reason == Engine::StepResult::Reason::GAME_OVER);
+    REQUIRE(game.getEvents().chosenAction(0).get() == 0);
+  }
+
+  SECTION("Engine::submit - full queue") {
+    size_t accepted = 0;
+    while (engine.submit(Command::Pause())) { accepted++; }
+    REQUIRE(accepted > 0);
+
+    // Draining makes room again
+    REQUIRE(engine.advance() == Engine::Status::PAUSED);
+    REQUIRE(engine.submit(Command::Resume()));
+  }
+}
+
+TEST_CASE("Engine - Stepping") {
+  const char *eventJson = R"(
+  [
+    {
+      "id": 0,
+      "actions": [0],
+      "description": "",
+      "display_name": "",
+      "mile": 0
+    },
+    {
+      "id": 1,
+      "actions": [0],
+      "description": "",
+      "display_name": "",
+      "mile": 3
+    }
+  ]
+  )";
+
+  Game game("", validActionJson, validEndingJson, eventJson, validIssueJson, validItemJson);
+  game.registerEventObserver(std::make_shared<TestObserver>(game));
+
+  // Never started, everything happens on this thread
+  Engine engine(game);
+
+  SECTION("Engine::advanceTicks") {
+    // The first tick is also the first hour
+    auto result = engine.advanceTicks(1);
+    REQUIRE(result.reason == Engine::StepResult::Reason::TICKS_ELAPSED);
+    REQUIRE(result.status == Engine::Status::RUNNING);
+    REQUIRE(result.ticks == 1);
+    REQUIRE(result.hours == 1);
+    REQUIRE(engine.getCurrentTick() == 0);
+
+    // Skips over idle ticks but still counts them
+    result = engine.advanceTicks(10);
+    REQUIRE(result.ticks == 10);
+    REQUIRE(result.hours == 0);
+    REQUIRE(engine.getCurrentTick() == 10);
+
+    result = engine.advanceTicks(rules::kTicksPerGameHour);
+    REQUIRE(result.ticks == rules::kTicksPerGameHour);
+    REQUIRE(result.hours == 1);
+    REQUIRE(engine.getCurrentTick() == 10 + rules::kTicksPerGameHour);
+    REQUIRE(engine.advanceTicks(0).ticks == 0);
+  }
+
+  SECTION("Engine::runUntil - next hour") {
+    REQUIRE(engine.runUntil(Engine::Until::NEXT_HOUR).ticks == 1);
+
+    auto result = engine.runUntil(Engine::Until::NEXT_HOUR);
+    REQUIRE(result.reason == Engine::StepResult::Reason::CONDITION_MET);
+    REQUIRE(result.hours == 1);
+    REQUIRE(engine.getCurrentTick() == rules::kTicksPerGameHour);
+  }
+
+  SECTION("Engine::runUntil - next mile") {
+    const auto mile = game.getCurrentMile();
+    auto result = engine.runUntil(Engine::Until::NEXT_MILE);
+    REQUIRE(result.reason == Engine::StepResult::Reason::CONDITION_MET);
+    REQUIRE(result.miles == 1);
+    REQUIRE(game.getCurrentMile() == mile + 1);
+
+    // Not enough time to get there
+    result = engine.runUntil(Engine::Until::NEXT_MILE, 1);
+    REQUIRE(result.reason == Engine::StepResult::Reason::TICKS_ELAPSED);
+    REQUIRE(result.miles == 0);
+  }
+
+  SECTION("Engine::runUntil - predicate") {
+    auto result = engine.runUntil([&game]() { return game.getCurrentMile() == 2; });
+    REQUIRE(result.reason == Engine::StepResult::Reason::CONDITION_MET);
+    REQUIRE(game.getCurrentMile() == 2);
+  }
+
+  SECTION("Engine::runUntil - game over") {
+    auto result = engine.runUntil(Engine::Until::BLOCKED);
+    REQUIRE(result.reason == Engine::StepResult::Reason::GAME_OVER);
+    REQUIRE(result.status == Engine::Status::GAME_OVER);
+    REQUIRE(result.miles == 3);
+    REQUIRE(result.ticks > 0);
+
+    // Nothing left to run
+    result = engine.advanceTicks(10);
+    REQUIRE(result.reason == Engine::StepResult::Reason::GAME_OVER);
+    REQUIRE(result.ticks == 0);
+  }
+}
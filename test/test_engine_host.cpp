@@ -0,0 +1,230 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "helpers.hpp"
+
+#include <libgtfoklahoma/engine_host.hpp>
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/pacing.hpp>
+#include <libgtfoklahoma/timer_wheel.hpp>
+
+using namespace libgtfoklahoma;
+using namespace testhelpers;
+
+namespace {
+const char *kTwoEventJson = R"(
+  [
+    {
+      "id": 0,
+      "actions": [0],
+      "description": "",
+      "display_name": "",
+      "mile": 0
+    },
+    {
+      "id": 1,
+      "actions": [0],
+      "description": "",
+      "display_name": "",
+      "mile": 5
+    }
+  ]
+  )";
+
+class GameOverObserver : public TestObserver {
+public:
+  explicit GameOverObserver(EngineStopper &stopper, Game &game) : TestObserver(game), stopper(stopper) {}
+  void onGameOver(const EndingModel &) override { stopper.stopEngine(); }
+private:
+  EngineStopper &stopper;
+};
+} // namespace
+
+TEST_CASE("TimerWheel", "[unit]") {
+  using Clock = TimerWheel<int>::Clock;
+  const auto start = Clock::now();
+  const auto resolution = std::chrono::milliseconds(10);
+  TimerWheel<int> wheel(resolution, 4, start);
+
+  wheel.schedule(start + resolution, 1);
+  wheel.schedule(start + resolution * 3, 3);
+
+  // Further out than a full rotation of the wheel
+  wheel.schedule(start + resolution * 9, 9);
+  REQUIRE(wheel.size() == 3);
+
+  std::vector<int> due;
+  wheel.advance(start + resolution, due);
+  REQUIRE(due == std::vector<int>{1});
+
+  due.clear();
+  wheel.advance(start + resolution * 5, due);
+  REQUIRE(due == std::vector<int>{3});
+
+  due.clear();
+  wheel.advance(start + resolution * 100, due);
+  REQUIRE(due == std::vector<int>{9});
+  REQUIRE(wheel.size() == 0);
+
+  // Anything scheduled in the past is due on the next advance
+  wheel.schedule(start, 0);
+  due.clear();
+  wheel.advance(start + resolution * 101, due);
+  REQUIRE(due == std::vector<int>{0});
+
+  // Empty slots are skipped, even past the end of a rotation
+  wheel.schedule(start + resolution * 1000, 1000);
+  REQUIRE(wheel.nextExpiry() == start + resolution * 1000);
+  due.clear();
+  wheel.advance(start + resolution * 110, due);
+  REQUIRE(due.empty());
+  REQUIRE(wheel.nextExpiry() == start + resolution * 1000);
+
+  wheel.schedule(start + resolution * 120, 120);
+  REQUIRE(wheel.nextExpiry() == start + resolution * 120);
+}
+
+TEST_CASE("EngineHost - Runs many sessions") {
+  const size_t kSessionCount = 32;
+  std::vector<std::unique_ptr<Game>> games;
+  std::vector<std::unique_ptr<EngineStopper>> stoppers;
+  for (size_t i = 0; i < kSessionCount; i++) {
+    games.emplace_back(std::make_unique<Game>("", validActionJson, validEndingJson, kTwoEventJson, validIssueJson, validItemJson));
+    stoppers.emplace_back(std::make_unique<EngineStopper>());
+    games.back()->registerEventObserver(std::make_shared<GameOverObserver>(*stoppers.back(), *games.back()));
+  }
+
+  EngineHost host(2, std::make_shared<UnthrottledPacing>());
+  for (auto &game : games) {
+    host.addSession(*game);
+  }
+
+  for (auto &stopper : stoppers) {
+    stopper->waitForEngineToStopOrFail();
+  }
+  for (auto &game : games) {
+    REQUIRE(game->getCurrentMile() == 5);
+  }
+}
+
+TEST_CASE("EngineHost - Sessions waiting on the player don't hold up a worker") {
+  // Sits on the decision until the test makes it
+  class SlowDeciderObserver : public GameOverObserver {
+  public:
+    explicit SlowDeciderObserver(EngineStopper &stopper, Game &game) : GameOverObserver(stopper, game) {}
+    bool onEvent(const EventModel &event) override {
+      pendingEvent = &event;
+      return true;
+    }
+    std::atomic<const EventModel *> pendingEvent{nullptr};
+  };
+
+  Game slowGame("", validActionJson, validEndingJson, kTwoEventJson, validIssueJson, validItemJson);
+  EngineStopper slowStopper;
+  auto slowObserver = std::make_shared<SlowDeciderObserver>(slowStopper, slowGame);
+  slowGame.registerEventObserver(slowObserver);
+
+  Game game("", validActionJson, validEndingJson, kTwoEventJson, validIssueJson, validItemJson);
+  EngineStopper stopper;
+  game.registerEventObserver(std::make_shared<GameOverObserver>(stopper, game));
+
+  // A single worker, so the second game can only finish if the first isn't hogging it
+  EngineHost host(1, std::make_shared<UnthrottledPacing>());
+  auto slowSession = host.addSession(slowGame);
+  host.addSession(game);
+  stopper.waitForEngineToStopOrFail();
+  REQUIRE(host.hasSession(slowSession));
+
+  const EventModel *pendingEvent = slowObserver->pendingEvent;
+  REQUIRE(pendingEvent);
+  REQUIRE(slowGame.getEvents().chooseAction(pendingEvent->id, 0));
+  slowStopper.waitForEngineToStopOrFail();
+}
+
+TEST_CASE("EngineHost - Commands wake up sessions waiting on the player") {
+  class SlowDeciderObserver : public GameOverObserver {
+  public:
+    explicit SlowDeciderObserver(EngineStopper &stopper, Game &game) : GameOverObserver(stopper, game) {}
+    bool onEvent(const EventModel &event) override {
+      pendingEvent = &event;
+      return true;
+    }
+    std::atomic<const EventModel *> pendingEvent{nullptr};
+  };
+
+  Game game("", validActionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
+  EngineStopper stopper;
+  auto observer = std::make_shared<SlowDeciderObserver>(stopper, game);
+  game.registerEventObserver(observer);
+
+  EngineHost host(1, std::make_shared<UnthrottledPacing>());
+  auto session = host.addSession(game);
+  while (!observer->pendingEvent) { std::this_thread::yield(); }
+
+  REQUIRE(host.submit(session, Command::ChooseEventAction(observer->pendingEvent.load()->id, 0)));
+  stopper.waitForEngineToStopOrFail();
+}
+
+TEST_CASE("EngineHost - Paused sessions aren't requeued once the player decides") {
+  class SlowDeciderObserver : public GameOverObserver {
+  public:
+    explicit SlowDeciderObserver(EngineStopper &stopper, Game &game) : GameOverObserver(stopper, game) {}
+    bool onEvent(const EventModel &event) override {
+      pendingEvent = &event;
+      return true;
+    }
+    std::atomic<const EventModel *> pendingEvent{nullptr};
+  };
+
+  Game game("", validActionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
+  EngineStopper stopper;
+  auto observer = std::make_shared<SlowDeciderObserver>(stopper, game);
+  game.registerEventObserver(observer);
+
+  EngineHost host(1, std::make_shared<UnthrottledPacing>());
+  auto session = host.addSession(game);
+  while (!observer->pendingEvent) { std::this_thread::yield(); }
+
+  REQUIRE(host.submit(session, Command::Pause()));
+  REQUIRE(game.getEvents().chooseAction(observer->pendingEvent.load()->id, 0));
+
+  // A session bouncing through the run queue would keep the worker busy
+  REQUIRE(cpuTimeWhileSleeping(std::chrono::milliseconds(200)) < std::chrono::milliseconds(100));
+
+  REQUIRE(host.submit(session, Command::Resume()));
+  stopper.waitForEngineToStopOrFail();
+}
+
+TEST_CASE("EngineHost - Removed sessions stop running") {
+  Game game("", validActionJson, validEndingJson, kTwoEventJson, validIssueJson, validItemJson);
+
+  // The clock never moves so the game is still going when it's removed
+  EngineHost host(1, std::make_shared<RealTimePacing>(), std::make_shared<VirtualClock>());
+  auto id = host.addSession(game);
+  REQUIRE(host.sessionCount() == 1);
+
+  host.removeSession(id);
+  REQUIRE_FALSE(host.hasSession(id));
+  REQUIRE(host.sessionCount() == 0);
+}
@@ -55,12 +55,12 @@ TEST_CASE("Events", "[unit]") {
   SECTION("Events::getEvent") {
     {
       auto &event = events.getEvent(0);
-      REQUIRE_FALSE(event == Events::kEmptyEventModel);
+      REQUIRE_FALSE(event == ContentCatalog::kEmptyEventModel);
     }
 
     {
       auto &event = events.getEvent(-1);
-      REQUIRE(event == Events::kEmptyEventModel);
+      REQUIRE(event == ContentCatalog::kEmptyEventModel);
     }
   }
 
@@ -76,10 +76,29 @@ TEST_CASE("Events", "[unit]") {
     REQUIRE_FALSE(events.hasMoreEvents(1));
   }
 
-  SECTION("EventModel::chooseAction") {
-    auto &event0 = events.getEvent(events.eventsAtMile(0)[0]);
-    event0.chooseAction(0);
-    REQUIRE(event0.chosenAction().get() == 0);
+  SECTION("Events::chooseAction") {
+    auto eventId = events.eventsAtMile(0)[0];
+    REQUIRE(events.chooseAction(eventId, 0));
+    REQUIRE(events.chosenAction(eventId).get() == 0);
+  }
+
+  SECTION("Events::handleEvent - the same event can come up again") {
+    class DeferringObserver : public TestObserver {
+    public:
+      explicit DeferringObserver(Game &game) : TestObserver(game) {}
+      bool onEvent(const EventModel &) override { return true; }
+    };
+    auto deferring = std::make_shared<DeferringObserver>(game);
+
+    for (int i = 0; i < 2; i++) {
+      events.handleEvent(0, deferring);
+      REQUIRE(game.awaitingInput());
+      REQUIRE_FALSE(game.inputIsReady());
+      REQUIRE(events.chooseAction(0, 0));
+      REQUIRE_FALSE(events.chooseAction(0, 0));
+      REQUIRE(game.resumeIfReady());
+      REQUIRE_FALSE(game.awaitingInput());
+    }
   }
 }
 
@@ -97,8 +116,8 @@ TEST_CASE("Events - Ending Hints") {
       REQUIRE(ending.id == 0);
       stopper.stopEngine();
     }
-    bool onEvent(EventModel &event) override {
-      event.chooseAction(0);
+    bool onEvent(const EventModel &event) override {
+      m_game.getEvents().chooseAction(event.id, 0);
       return true;
     }
   private:
@@ -108,7 +127,7 @@ TEST_CASE("Events - Ending Hints") {
   auto observer = std::make_unique<SuicideObserver>(stopper, game);
   game.registerEventObserver(std::move(observer));
 
-  Engine engine(game);
+  Engine engine(game, std::make_shared<RealTimePacing>(), fastForwardClock());
   engine.start();
   stopper.waitForEngineToStopOrFail();
 }
@@ -123,7 +142,7 @@ TEST_CASE("Events - Chosen failable actions apply stats correctly") {
     , TestObserver(game) {}
 
     void onGameOver(const EndingModel &) override { stopper.stopEngine(); }
-    bool onEvent(EventModel &event) override {
+    bool onEvent(const EventModel &event) override {
       if (expect_failure) {
         REQUIRE(m_game.getActions().getAction(0).message_failure ==
                 "message_failure");
@@ -131,7 +150,7 @@ TEST_CASE("Events - Chosen failable actions apply stats correctly") {
         REQUIRE(m_game.getActions().getAction(0).message_success ==
                 "message_success");
       }
-      event.chooseAction(0);
+      m_game.getEvents().chooseAction(event.id, 0);
       return true;
     }
   private:
@@ -157,7 +176,7 @@ TEST_CASE("Events - Chosen failable actions apply stats correctly") {
     EngineStopper stopper;
     Game game("", actionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
     game.registerEventObserver(std::make_shared<Observer>(true, stopper, game));
-    Engine engine(game);
+    Engine engine(game, std::make_shared<RealTimePacing>(), fastForwardClock());
     auto initial_health = game.getStats().getPlayerStatsModel().health;
     auto expected_health = initial_health - 1000;
     engine.start();
@@ -183,7 +202,7 @@ TEST_CASE("Events - Chosen failable actions apply stats correctly") {
     EngineStopper stopper;
     Game game("", actionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
     game.registerEventObserver(std::make_shared<Observer>(false, stopper, game));
-    Engine engine(game);
+    Engine engine(game, std::make_shared<RealTimePacing>(), fastForwardClock());
     auto initial_health = game.getStats().getPlayerStatsModel().health;
     auto expected_health = initial_health - 1000;
     engine.start();
@@ -0,0 +1,64 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <libgtfoklahoma/fenwick_tree.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("FenwickTree", "[unit]") {
+
+  SECTION("FenwickTree::prefixSum") {
+    FenwickTree<int32_t> tree(10);
+    REQUIRE(tree.size() == 10);
+    REQUIRE(tree.total() == 0);
+
+    for (size_t i = 0; i < 10; ++i) {
+      tree.add(i, static_cast<int32_t>(i));
+    }
+    tree.add(10, 100); // Out of range, ignored
+    REQUIRE(tree.total() == 45);
+    REQUIRE(tree.prefixSum(0) == 0);
+    REQUIRE(tree.prefixSum(4) == 6);
+    REQUIRE(tree.prefixSum(10) == 45);
+    REQUIRE(tree.prefixSum(20) == 45);
+
+    tree.add(3, -3);
+    REQUIRE(tree.prefixSum(4) == 3);
+    REQUIRE(tree.total() == 42);
+  }
+
+  SECTION("FenwickTree::upperBound") {
+    FenwickTree<int32_t> tree(7);
+    tree.add(1, 1);
+    tree.add(4, 2);
+    tree.add(6, 1);
+
+    REQUIRE(tree.upperBound(0) == 1);
+    REQUIRE(tree.upperBound(1) == 4);
+    REQUIRE(tree.upperBound(2) == 4);
+    REQUIRE(tree.upperBound(3) == 6);
+    REQUIRE(tree.upperBound(4) == tree.size());
+
+    // Same as walking a list of just the non-zero entries
+    tree.add(4, -2);
+    REQUIRE(tree.upperBound(1) == 6);
+
+    REQUIRE(FenwickTree<int32_t>().upperBound(0) == 0);
+  }
+}
@@ -46,16 +46,22 @@ TEST_CASE("Game", "[unit]") {
     game.addItemToInventory(0);
     auto inventory = game.getInventory();
     REQUIRE(inventory.size() == 1);
-    REQUIRE(inventory[0].get().id == 0);
+    REQUIRE((*inventory.begin()).item.id == 0);
+    REQUIRE((*inventory.begin()).quantity == 1);
   }
 
   SECTION("Game::getInventory - explicit quantity") {
     game.addItemToInventory(0, 10);
+    game.addItemToInventory(1, 2);
     auto inventory = game.getInventory();
-    REQUIRE(inventory.size() == 10);
-    for (const auto &item : inventory) {
-      REQUIRE(item.get().id == 0);
+    REQUIRE(inventory.size() == 2);
+
+    std::vector<std::pair<int32_t, int32_t>> items;
+    for (const auto &[item, quantity] : inventory) {
+      items.emplace_back(item.id, quantity);
     }
+    REQUIRE(items == std::vector<std::pair<int32_t, int32_t>>{{0, 10}, {1, 2}});
+    REQUIRE(game.inventoryCount(0) == 10);
   }
 
   SECTION("Game::getStats") {
@@ -114,6 +120,19 @@ TEST_CASE("Game", "[unit]") {
     REQUIRE(updatedModel.pace == expected_pace);
     REQUIRE(updatedModel.wakeup_hour == initialModel.wakeup_hour + 1);
   }
+
+  SECTION("Game::getPlayerState") {
+    REQUIRE(game.getPlayerState().stats == game.getStats().getPlayerStatsModel());
+
+    game.updateStats(StatModel(0, -10));
+    game.setCurrentMile(12);
+    game.setCurrentHour(7);
+
+    const auto state = game.getPlayerState();
+    REQUIRE(state.stats == game.getStats().getPlayerStatsModel());
+    REQUIRE(state.mile == 12);
+    REQUIRE(state.hour == 7);
+  }
 }
 
 TEST_CASE("Game - EndingStack") {
@@ -140,8 +159,8 @@ TEST_CASE("Game - EndingStack") {
         REQUIRE(m_game.popEndingHintId() == -1);
         stopper.stopEngine();
       }
-      bool onEvent(EventModel &event) override {
-        event.chooseAction(0);
+      bool onEvent(const EventModel &event) override {
+        m_game.getEvents().chooseAction(event.id, 0);
         return true;
       }
     private:
@@ -154,9 +173,204 @@ TEST_CASE("Game - EndingStack") {
     auto observer = std::make_unique<SuicideObserver>(stopper, game);
     game.registerEventObserver(std::move(observer));
 
-    Engine engine(game);
+    Engine engine(game, std::make_shared<RealTimePacing>(), fastForwardClock());
     engine.start();
     stopper.waitForEngineToStopOrFail();
   }
 }
 
+
+TEST_CASE("Game - Ticks") {
+  class TickObserver : public TestObserver {
+  public:
+    explicit TickObserver(Game &game) : TestObserver(game) {}
+    void onStatsChanged(const StatModel &) override { statsChanged++; }
+    void onTickCommitted(const TickChangeSet &changes) override { committed.push_back(changes); }
+    int statsChanged = 0;
+    std::vector<TickChangeSet> committed;
+  };
+
+  Game game("", validActionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
+  auto observer = std::make_shared<TickObserver>(game);
+  game.registerEventObserver(observer);
+
+  SECTION("Game::updateStats - outside a tick") {
+    game.updateStats(StatModel(0, -1));
+    game.updateStats(StatModel(0, -1));
+    REQUIRE(observer->statsChanged == 2);
+    REQUIRE(observer->committed.empty());
+  }
+
+  SECTION("Game::addItemToInventory - one notification") {
+    const auto before = game.getStats().getPlayerStatsModel();
+    game.addItemToInventory(0, 50);
+    REQUIRE(observer->statsChanged == 1);
+    REQUIRE(game.getStats().getPlayerStatsModel() ==
+            before + game.getItems().getItem(0).stat_delta * 50);
+  }
+
+  SECTION("Game::addItemsToInventory") {
+    const auto before = game.getStats().getPlayerStatsModel();
+    game.addItemsToInventory({{0, 20}});
+    game.addItemsToInventory({});
+    REQUIRE(observer->statsChanged == 1);
+    REQUIRE(game.inventoryCount(0) == 20);
+    REQUIRE(game.getStats().getPlayerStatsModel() ==
+            before + game.getItems().getItem(0).stat_delta * 20);
+
+    game.removeItemsFromInventory({{0, 20}});
+    REQUIRE_FALSE(game.inventoryCount(0));
+  }
+
+  SECTION("Game::addItemToInventory - nothing to add") {
+    const auto before = game.getStats().getPlayerStatsModel();
+    game.addItemToInventory(0, 0);
+    game.addItemToInventory(0, -2);
+    game.addItemsToInventory({{0, -1}});
+    REQUIRE(observer->statsChanged == 0);
+    REQUIRE_FALSE(game.inventoryCount(0));
+    REQUIRE(game.getStats().getPlayerStatsModel() == before);
+
+    // Only the positive quantities count
+    game.addItemsToInventory({{0, 2}, {1, -3}});
+    REQUIRE(observer->statsChanged == 1);
+    REQUIRE(game.inventoryCount(0) == 2);
+    REQUIRE(game.getStats().getPlayerStatsModel() ==
+            before + game.getItems().getItem(0).stat_delta * 2);
+  }
+
+  SECTION("Game::commitTick - changes are coalesced") {
+    const auto before = game.getStats().getPlayerStatsModel();
+    game.beginTick(7);
+    game.updateStats(StatModel(0, -1));
+    game.addItemToInventory(0, 3);
+    game.removeItemFromInventory(0, 1);
+    game.setCurrentMile(1);
+
+    // Opening it again changes nothing
+    game.beginTick(8);
+    game.updateStats(StatModel(0, -1));
+    REQUIRE(observer->statsChanged == 0);
+
+    game.commitTick();
+    REQUIRE(observer->statsChanged == 1);
+    REQUIRE(observer->committed.size() == 1);
+
+    const auto &changes = observer->committed.front();
+    REQUIRE(changes.tick == 7);
+    REQUIRE(changes.stats_before == before);
+    REQUIRE(changes.stats_after == game.getStats().getPlayerStatsModel());
+    REQUIRE(changes.inventory_delta == std::map<int32_t, int32_t>{{0, 2}});
+    REQUIRE(changes.mileChanged());
+    REQUIRE_FALSE(changes.hourChanged());
+
+    // Nothing left open
+    game.commitTick();
+    REQUIRE(observer->committed.size() == 1);
+  }
+
+  SECTION("Game::commitTick - nothing changed") {
+    game.beginTick(0);
+    game.updateStats(StatModel(0, 5, 0, 0));
+    game.updateStats(StatModel(0, -5, 0, 0));
+    game.commitTick();
+
+    REQUIRE(observer->statsChanged == 0);
+    REQUIRE(observer->committed.size() == 1);
+    REQUIRE(observer->committed.front().inventory_delta.empty());
+  }
+
+  SECTION("Engine::advance - once per tick") {
+    Engine engine(game, std::make_shared<UnthrottledPacing>());
+    while (engine.advance() == Engine::Status::RUNNING) {}
+    REQUIRE_FALSE(observer->committed.empty());
+    for (size_t i = 1; i < observer->committed.size(); ++i) {
+      REQUIRE(observer->committed[i].tick > observer->committed[i - 1].tick);
+      REQUIRE(observer->committed[i].stats_before == observer->committed[i - 1].stats_after);
+    }
+  }
+}
+
+TEST_CASE("Game - Purchases show up while shopping") {
+  const char *actionJson = R"(
+  [
+    {
+      "display_name": "",
+      "id": 0,
+      "items": [0],
+      "type": ["STORE"]
+    }
+  ]
+  )";
+
+  const char *itemJson = R"(
+  [
+    {
+      "id": 0,
+      "category": "MISC",
+      "cost": 1,
+      "display_name": "",
+      "image_url": "",
+      "stat_changes": [{"money_remaining": -1}]
+    },
+    {
+      "id": 1,
+      "category": "MISC",
+      "cost": 1,
+      "display_name": "",
+      "image_url": "",
+      "stat_changes": [{"money_remaining": -1}]
+    }
+  ]
+  )";
+
+  // Walks into the store and leaves the shopping to the test
+  class ShopperObserver : public TestObserver {
+  public:
+    explicit ShopperObserver(Game &game) : TestObserver(game) {}
+    bool onEvent(const EventModel &event) override { return m_game.getEvents().chooseAction(event.id, 0); }
+    bool onStoreEntered(const ActionModel &) override { return true; }
+    void onStatsChanged(const StatModel &stats) override { money.push_back(stats.money_remaining); }
+    std::vector<int32_t> money;
+  };
+
+  Game game("", actionJson, validEndingJson, validEventJson, validIssueJson, itemJson);
+  StatModel funds;
+  funds.money_remaining = 10;
+  game.updateStats(funds);
+  const auto money = game.getStats().getPlayerStatsModel().money_remaining;
+  auto observer = std::make_shared<ShopperObserver>(game);
+  game.registerEventObserver(observer);
+
+  SECTION("Game::flushTick - inside an open tick") {
+    game.beginTick(0);
+    REQUIRE(game.getActions().purchaseItem(0, 0));
+    REQUIRE(game.getActions().purchaseItem(0, 0));
+    REQUIRE(observer->money == std::vector<int32_t>{money - 1, money - 2});
+    game.commitTick();
+    REQUIRE(observer->money.size() == 2);
+  }
+
+  SECTION("Engine::advance - while waiting to leave the store") {
+    Engine engine(game, std::make_shared<UnthrottledPacing>());
+    REQUIRE(engine.advance() == Engine::Status::AWAITING_INPUT);
+    observer->money.clear();
+
+    // Not a store the player is in, or not something it stocks
+    REQUIRE(engine.submit(Command::PurchaseItem(5, 0)));
+    REQUIRE(engine.submit(Command::PurchaseItem(0, 1)));
+    REQUIRE(engine.advance() == Engine::Status::AWAITING_INPUT);
+    REQUIRE(observer->money.empty());
+    REQUIRE_FALSE(game.inventoryCount(1));
+
+    for (int32_t i = 0; i < 3; i++) {
+      REQUIRE(engine.submit(Command::PurchaseItem(0, 0)));
+      REQUIRE(engine.advance() == Engine::Status::AWAITING_INPUT);
+    }
+    REQUIRE(observer->money == std::vector<int32_t>{money - 1, money - 2, money - 3});
+
+    REQUIRE(engine.submit(Command::LeaveStore(0)));
+    REQUIRE(engine.advance() != Engine::Status::AWAITING_INPUT);
+    REQUIRE(game.inventoryCount(0) == 3);
+  }
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include <libgtfoklahoma/inventory.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("Inventory", "[unit]") {
+  Inventory inventory;
+  REQUIRE(inventory.empty());
+  REQUIRE(inventory.count(0) == 0);
+  REQUIRE_FALSE(inventory.find(0));
+
+  SECTION("Inventory::add - kept in id order") {
+    inventory.add(5, 1);
+    inventory.add(1, 2);
+    inventory.add(3, 3);
+    inventory.add(1, 2);
+    inventory.add(7, 0);
+
+    std::vector<Inventory::Entry> entries(inventory.begin(), inventory.end());
+    REQUIRE(entries == std::vector<Inventory::Entry>{{1, 4}, {3, 3}, {5, 1}});
+    REQUIRE(inventory.count(1) == 4);
+    REQUIRE(inventory.find(3)->quantity == 3);
+    REQUIRE(inventory.count(7) == 0);
+  }
+
+  SECTION("Inventory::remove") {
+    inventory.add(1, 3);
+    inventory.add(2, 1);
+
+    REQUIRE(inventory.remove(1, 2) == 2);
+    REQUIRE(inventory.count(1) == 1);
+
+    // Can't remove more than there is
+    REQUIRE(inventory.remove(1, 5) == 1);
+    REQUIRE_FALSE(inventory.find(1));
+    REQUIRE(inventory.remove(1, 1) == 0);
+    REQUIRE(inventory.size() == 1);
+  }
+
+  SECTION("Inventory::operator==") {
+    Inventory other;
+    other.add(2, 1);
+    other.add(1, 1);
+    inventory.add(1, 1);
+    REQUIRE_FALSE(inventory == other);
+    inventory.add(2, 1);
+    REQUIRE(inventory == other);
+  }
+}
@@ -60,8 +60,8 @@ TEST_CASE("Issues", "[unit]") {
   class Observer : public TestObserver {
   public:
     explicit Observer(Game &game) : TestObserver(game) {}
-    bool onIssueOccurred(IssueModel &issue) override {
-      issue.chooseAction(0);
+    bool onIssueOccurred(const IssueModel &issue) override {
+      m_game.getIssues().chooseAction(issue.id, 0);
       return true;
     }
   };
@@ -74,21 +74,41 @@ TEST_CASE("Issues", "[unit]") {
 
     // Issue can't be served again
     id = issues.popRandomIssueId(IssueModel::Type::HEALTH);
-    REQUIRE(issues.getIssue(id) == Issues::kEmptyIssueModel);
+    REQUIRE(issues.getIssue(id) == ContentCatalog::kEmptyIssueModel);
 
     // Dependent actions and inventory work
     id = issues.popRandomIssueId(IssueModel::Type::MECHANICAL);
-    REQUIRE(issues.getIssue(id) == Issues::kEmptyIssueModel);
+    REQUIRE(issues.getIssue(id) == ContentCatalog::kEmptyIssueModel);
     game.getActions().handleAction(0, std::make_unique<Observer>(game));
 
     // Should still be empty as inventory requirements aren't met
     id = issues.popRandomIssueId(IssueModel::Type::MECHANICAL);
-    REQUIRE(issues.getIssue(id) == Issues::kEmptyIssueModel);
+    REQUIRE(issues.getIssue(id) == ContentCatalog::kEmptyIssueModel);
 
     // NOW we should get the issue as all requirments have been met
     game.addItemToInventory(0);
     id = issues.popRandomIssueId(IssueModel::Type::MECHANICAL);
-    REQUIRE_FALSE(issues.getIssue(id) == Issues::kEmptyIssueModel);
+    REQUIRE_FALSE(issues.getIssue(id) == ContentCatalog::kEmptyIssueModel);
+  }
+
+  SECTION("Issues::popRandomIssue - follows the inventory") {
+    game.addItemToInventory(0, 2);
+    REQUIRE(issues.popRandomIssueId(IssueModel::Type::MECHANICAL) == 10);
+
+    game.removeItemFromInventory(0);
+    REQUIRE(issues.popRandomIssueId(IssueModel::Type::MECHANICAL) == 10);
+
+    game.removeItemFromInventory(0);
+    REQUIRE(issues.popRandomIssueId(IssueModel::Type::MECHANICAL) == -1);
+
+    // Restores are picked up too
+    Inventory inventory;
+    inventory.add(0, 1);
+    game.setInventoryCounts(inventory);
+    REQUIRE(issues.popRandomIssueId(IssueModel::Type::MECHANICAL) == 10);
+
+    issues.setIssuesThatHaveAlreadyHappened({10});
+    REQUIRE(issues.popRandomIssueId(IssueModel::Type::MECHANICAL) == -1);
   }
 
   SECTION("Issues::getIssuesThatHaveAlreadyHappened") {
@@ -152,20 +172,20 @@ TEST_CASE("Issues - Ending Hints") {
     }
     void onHourChanged(int32_t hour) override {}
     void onMileChanged(int32_t mile) override {}
-    bool onEvent(EventModel &event) override {
+    bool onEvent(const EventModel &event) override {
       return false; }
-    bool onIssueOccurred(IssueModel &issue) override {
-      issue.chooseAction(0);
+    bool onIssueOccurred(const IssueModel &issue) override {
+      m_game.getIssues().chooseAction(issue.id, 0);
       return true;
     }
     void onStatsChanged(const StatModel &stats) override {}
-    bool onStoreEntered(ActionModel &action) override { return false; }
+    bool onStoreEntered(const ActionModel &action) override { return false; }
   };
 
   auto observer = std::make_unique<SuicideObserver>(game);
   game.registerEventObserver(std::move(observer));
 
-  Engine engine(game);
+  Engine engine(game, std::make_shared<RealTimePacing>(), fastForwardClock());
   engine.start();
 
   std::unique_lock<std::mutex> lock(TestIssueEndingHints::mutex);
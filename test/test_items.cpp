@@ -45,10 +45,10 @@ TEST_CASE("Items", "[unit]") {
 
   SECTION("Items::getItem") {
     auto item = items.getItem(0);
-    REQUIRE_FALSE(item == Items::kEmptyItemModel);
+    REQUIRE_FALSE(item == ContentCatalog::kEmptyItemModel);
 
     item = items.getItem(-1);
-    REQUIRE(item == Items::kEmptyItemModel);
+    REQUIRE(item == ContentCatalog::kEmptyItemModel);
   }
 
 }
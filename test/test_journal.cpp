@@ -0,0 +1,215 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+#include "helpers.hpp"
+
+#include <libgtfoklahoma/engine.hpp>
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/journal.hpp>
+#include <libgtfoklahoma/pacing.hpp>
+#include <libgtfoklahoma/simulator.hpp>
+
+using namespace libgtfoklahoma;
+using namespace testhelpers;
+
+namespace {
+const char *kActionJson = R"(
+  [
+    {
+      "id": 0,
+      "display_name": "Nap",
+      "type": ["STAT_CHANGE"],
+      "can_fail": true,
+      "success_chance": 0.5,
+      "stat_changes_on_success": [{"health": 10}],
+      "stat_changes_on_failure": [{"health": -10}]
+    },
+    {
+      "id": 1,
+      "display_name": "Push on",
+      "type": ["STAT_CHANGE"],
+      "stat_changes_regardless": [{"health": -5}]
+    },
+    {
+      "id": 2,
+      "display_name": "Bike shop",
+      "type": ["STORE"],
+      "items": [0]
+    }
+  ]
+  )";
+
+const char *kEventJson = R"(
+  [
+    {"id": 0, "actions": [0, 1], "description": "", "display_name": "", "mile": 0},
+    {"id": 1, "actions": [2], "description": "", "display_name": "", "mile": 3},
+    {"id": 2, "actions": [0, 1], "description": "", "display_name": "", "mile": 6}
+  ]
+  )";
+
+const char *kItemJson = R"(
+  [
+    {
+        "id": 0,
+        "category": "MISC",
+        "cost": 20,
+        "display_name": "Spare tube",
+        "image_url": "",
+        "stat_changes": [{"money_remaining": -20}, {"odds_mech_issue": -0.1}]
+    }
+  ]
+  )";
+
+std::unique_ptr<Game> makeGame(uint64_t seed, const char *eventJson=kEventJson) {
+  return std::make_unique<Game>("", kActionJson, validEndingJson, eventJson, validIssueJson, kItemJson, seed);
+}
+
+Journal record(uint64_t seed) {
+  auto game = makeGame(seed);
+  auto journal = std::make_shared<Journal>();
+  game->recordTo(journal);
+  sim::ScriptedPolicy policy({{0, 0}, {2, 1}}, {}, {0});
+  sim::Simulate(*game, policy, 1000000);
+  return *journal;
+}
+}
+
+TEST_CASE("Journal - Serialization", "[unit]") {
+  Journal journal(0xdeadbeefcafef00d, 42);
+  journal.append({JournalEntry::Type::EVENT_ACTION, 0, 1});
+  journal.append({JournalEntry::Type::PURCHASE, 2, -7});
+  journal.append({JournalEntry::Type::LEAVE_STORE, 2});
+  journal.append({JournalEntry::Type::ISSUE_DECLINED, 5});
+  JournalOutcome outcome;
+  outcome.ending_id = 3;
+  outcome.mile = 123;
+  outcome.stats.odds_mech_issue = 0.125;
+  journal.setOutcome(outcome);
+
+  auto bytes = journal.serialize();
+  auto copy = Journal::Deserialize(bytes.data(), bytes.size());
+  REQUIRE(copy);
+  REQUIRE(copy->getSeed() == journal.getSeed());
+  REQUIRE(copy->getContentHash() == 42);
+  REQUIRE(copy->getEntries() == journal.getEntries());
+  REQUIRE(copy->getOutcome() == journal.getOutcome());
+
+  // Truncated or corrupted journals are rejected rather than half-read
+  REQUIRE_FALSE(Journal::Deserialize(bytes.data(), bytes.size() - 1));
+  REQUIRE_FALSE(Journal::Deserialize(bytes.data() + 1, bytes.size() - 1));
+  bytes.push_back(0);
+  REQUIRE_FALSE(Journal::Deserialize(bytes.data(), bytes.size()));
+}
+
+TEST_CASE("Journal - Record and replay") {
+  auto journal = record(7);
+  REQUIRE(journal.getSeed() == 7);
+  REQUIRE(journal.getOutcome());
+  REQUIRE(journal.getOutcome()->mile == 6);
+
+  // Every input the policy made was captured, including the trip to the store
+  const auto &entries = journal.getEntries();
+  REQUIRE(std::count(entries.begin(), entries.end(), JournalEntry{JournalEntry::Type::EVENT_ACTION, 0, 0}) == 1);
+  REQUIRE(std::count(entries.begin(), entries.end(), JournalEntry{JournalEntry::Type::PURCHASE, 2, 0}) == 1);
+  REQUIRE(std::count(entries.begin(), entries.end(), JournalEntry{JournalEntry::Type::LEAVE_STORE, 2, -1}) == 1);
+
+  // The policy answered everything so nothing was declined
+  REQUIRE(std::none_of(entries.begin(), entries.end(), [](const JournalEntry &entry) {
+    return entry.type == JournalEntry::Type::EVENT_DECLINED || entry.type == JournalEntry::Type::ISSUE_DECLINED;
+  }));
+
+  SECTION("Replays to the same outcome") {
+    auto bytes = journal.serialize();
+    auto copy = Journal::Deserialize(bytes.data(), bytes.size());
+    REQUIRE(copy);
+
+    auto game = makeGame(7);
+    auto result = Replay(*copy, *game);
+    INFO(result.mismatch);
+    REQUIRE(result.matches);
+    REQUIRE(result.outcome == *journal.getOutcome());
+  }
+
+  SECTION("Different seed") {
+    auto game = makeGame(8);
+    REQUIRE_FALSE(Replay(journal, *game).matches);
+  }
+
+  SECTION("Different content") {
+    const char *eventJson = R"(
+    [
+      {"id": 0, "actions": [0, 1], "description": "", "display_name": "", "mile": 0},
+      {"id": 2, "actions": [0, 1], "description": "", "display_name": "", "mile": 6}
+    ]
+    )";
+    auto game = makeGame(7, eventJson);
+    auto result = Replay(journal, *game);
+    REQUIRE_FALSE(result.matches);
+    REQUIRE(result.mismatch == "Journal was recorded with different content");
+  }
+
+  SECTION("Tampered inputs are caught") {
+    Journal tampered(journal.getSeed(), journal.getContentHash());
+    for (auto entry : journal.getEntries()) {
+      if (entry.type == JournalEntry::Type::EVENT_ACTION && entry.id == 0) { entry.value = 1; }
+      tampered.append(entry);
+    }
+    tampered.setOutcome(*journal.getOutcome());
+
+    auto game = makeGame(7);
+    REQUIRE_FALSE(Replay(tampered, *game).matches);
+  }
+}
+
+TEST_CASE("Journal - Declined prompts are replayed") {
+  // Lets the first event go by and ignores every issue
+  class DecliningObserver : public TestObserver {
+  public:
+    explicit DecliningObserver(Game &game) : TestObserver(game) {}
+    bool onEvent(const EventModel &event) override {
+      if (event.id == 0) { return false; }
+      return m_game.getEvents().chooseAction(event.id, event.action_ids.front());
+    }
+    bool onStoreEntered(const ActionModel &action) override {
+      m_game.getActions().completePurchase(action.id);
+      return true;
+    }
+  };
+
+  auto game = makeGame(7);
+  auto journal = std::make_shared<Journal>();
+  game->recordTo(journal);
+  game->registerEventObserver(std::make_shared<DecliningObserver>(*game));
+  Engine engine(*game, std::make_shared<UnthrottledPacing>());
+  REQUIRE(engine.runUntil(Engine::Until::BLOCKED).reason == Engine::StepResult::Reason::GAME_OVER);
+
+  const auto &entries = journal->getEntries();
+  REQUIRE(std::count(entries.begin(), entries.end(), JournalEntry{JournalEntry::Type::EVENT_DECLINED, 0}) == 1);
+  REQUIRE(std::count_if(entries.begin(), entries.end(), [](const JournalEntry &entry) {
+    return entry.type == JournalEntry::Type::EVENT_DECLINED;
+  }) == 1);
+
+  auto replayed = makeGame(7);
+  auto result = Replay(*journal, *replayed);
+  INFO(result.mismatch);
+  REQUIRE(result.matches);
+  REQUIRE(result.outcome == *journal->getOutcome());
+}
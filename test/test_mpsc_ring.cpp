@@ -0,0 +1,97 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <libgtfoklahoma/mpsc_ring.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("MpscRing", "[unit]") {
+
+  SECTION("MpscRing::capacity") {
+    REQUIRE(MpscRing<int>(0).capacity() == 1);
+    REQUIRE(MpscRing<int>(5).capacity() == 8);
+    REQUIRE(MpscRing<int>(8).capacity() == 8);
+  }
+
+  SECTION("MpscRing::tryPush - full") {
+    MpscRing<int> ring(4);
+    for (int i = 0; i < 4; ++i) {
+      REQUIRE(ring.tryPush(i));
+    }
+    REQUIRE_FALSE(ring.tryPush(4));
+
+    int value = -1;
+    REQUIRE(ring.tryPop(value));
+    REQUIRE(value == 0);
+    REQUIRE(ring.tryPush(4));
+  }
+
+  SECTION("MpscRing::tryPop - in order") {
+    MpscRing<int> ring(4);
+    int value = -1;
+    REQUIRE_FALSE(ring.hasPending());
+    REQUIRE_FALSE(ring.tryPop(value));
+
+    // Go around a few times
+    for (int i = 0; i < 10; ++i) {
+      REQUIRE(ring.tryPush(i));
+      REQUIRE(ring.hasPending());
+      REQUIRE(ring.tryPop(value));
+      REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(ring.hasPending());
+  }
+
+  SECTION("MpscRing - many producers") {
+    const int kProducers = 4;
+    const int kPerProducer = 10000;
+    MpscRing<std::pair<int, int>> ring(16);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < kProducers; ++producer) {
+      producers.emplace_back([&ring, producer]() {
+        for (int i = 0; i < kPerProducer; ++i) {
+          while (!ring.tryPush({producer, i})) { std::this_thread::yield(); }
+        }
+      });
+    }
+
+    // Each producer's values come out in the order they went in
+    std::vector<int> next(kProducers, 0);
+    bool inOrder = true;
+    int received = 0;
+    std::pair<int, int> value;
+    while (received < kProducers * kPerProducer) {
+      if (!ring.tryPop(value)) {
+        std::this_thread::yield();
+        continue;
+      }
+      inOrder &= value.second == next[value.first];
+      next[value.first] = value.second + 1;
+      received++;
+    }
+
+    for (auto &producer : producers) { producer.join(); }
+    REQUIRE(inOrder);
+    REQUIRE_FALSE(ring.hasPending());
+  }
+}
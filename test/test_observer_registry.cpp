@@ -0,0 +1,65 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/observer_registry.hpp>
+
+#include "helpers.hpp"
+
+using namespace libgtfoklahoma;
+using namespace testhelpers;
+
+TEST_CASE("ObserverRegistry", "[unit]") {
+  Game game("", validActionJson, validEndingJson, validEventJson, validIssueJson, validItemJson);
+  ObserverRegistry registry;
+  REQUIRE(registry.get().empty());
+
+  SECTION("ObserverRegistry::add") {
+    auto observer = std::make_shared<TestObserver>(game);
+    registry.add(observer);
+    REQUIRE(registry.get().size() == 1);
+    REQUIRE(registry.get().front() == observer);
+  }
+
+  SECTION("ObserverRegistry::get - lists already handed out don't change") {
+    registry.add(std::make_shared<TestObserver>(game));
+    const auto &before = registry.get();
+
+    std::thread([&registry, &game]() {
+      for (int i = 0; i < 10; ++i) {
+        registry.add(std::make_shared<TestObserver>(game));
+      }
+    }).join();
+
+    REQUIRE(before.size() == 1);
+    REQUIRE(registry.get().size() == 11);
+    REQUIRE(registry.get().front() == before.front());
+  }
+
+  SECTION("ObserverRegistry::get - no refcount churn") {
+    auto observer = std::make_shared<TestObserver>(game);
+    registry.add(observer);
+    const auto useCount = observer.use_count();
+    for (const auto &registered : registry.get()) {
+      REQUIRE(registered.use_count() == useCount);
+    }
+  }
+}
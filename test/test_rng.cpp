@@ -0,0 +1,108 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include "helpers.hpp"
+
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/rng.hpp>
+
+using namespace libgtfoklahoma;
+using namespace testhelpers;
+
+TEST_CASE("Rng", "[unit]") {
+  SECTION("Same seed and stream, same numbers") {
+    Rng a(1234, 1);
+    Rng b(1234, 1);
+    for (int i = 0; i < 100; i++) {
+      REQUIRE(a.next() == b.next());
+    }
+  }
+
+  SECTION("Different seeds or streams, different numbers") {
+    Rng a(1234, 0);
+    Rng b(1234, 1);
+    Rng c(1235, 0);
+    auto first = a.next();
+    REQUIRE(first != b.next());
+    REQUIRE(first != c.next());
+  }
+
+  SECTION("Ranges") {
+    Rng rng(42);
+    std::vector<int> counts(6);
+    bool inRange = true;
+    for (int i = 0; i < 6000; i++) {
+      auto d = rng.nextDouble();
+      inRange &= d >= 0 && d < 1;
+
+      auto roll = rng.nextBelow(6);
+      inRange &= roll < 6;
+      if (roll < 6) { counts[roll]++; }
+    }
+    REQUIRE(inRange);
+    for (auto count : counts) {
+      REQUIRE(count > 800);
+      REQUIRE(count < 1200);
+    }
+  }
+
+  SECTION("State round trips") {
+    Rng a(7);
+    a.next();
+    Rng b;
+    b.setState(a.getState());
+    REQUIRE(a.next() == b.next());
+  }
+}
+
+TEST_CASE("Rng - Games are reproducible") {
+  const char *actionJson = R"(
+  [
+    {"id": 0, "display_name": "", "type": ["STAT_CHANGE"], "success_chance": 0.5},
+    {"id": 1, "display_name": "", "type": ["STAT_CHANGE"], "success_chance": 0.5},
+    {"id": 2, "display_name": "", "type": ["STAT_CHANGE"], "success_chance": 0.5},
+    {"id": 3, "display_name": "", "type": ["STAT_CHANGE"], "success_chance": 0.5},
+    {"id": 4, "display_name": "", "type": ["STAT_CHANGE"], "success_chance": 0.5},
+    {"id": 5, "display_name": "", "type": ["STAT_CHANGE"], "success_chance": 0.5},
+    {"id": 6, "display_name": "", "type": ["STAT_CHANGE"], "success_chance": 0.5},
+    {"id": 7, "display_name": "", "type": ["STAT_CHANGE"], "success_chance": 0.5}
+  ]
+  )";
+
+  auto outcomes = [&](uint64_t seed) {
+    Game game("", actionJson, validEndingJson, validEventJson, validIssueJson, validItemJson, seed);
+    REQUIRE(game.getSeed() == seed);
+
+    std::vector<bool> result;
+    for (int32_t id = 0; id < 8; id++) {
+      result.push_back(game.getActions().actionFailed(id));
+    }
+    for (int i = 0; i < 8; i++) {
+      result.push_back(game.getIssueRng().nextBelow(2));
+    }
+    return result;
+  };
+
+  REQUIRE(outcomes(99) == outcomes(99));
+
+  // 16 coin flips all coming up the same for two seeds would be quite the coincidence
+  REQUIRE(outcomes(99) != outcomes(100));
+}
@@ -23,6 +23,7 @@
 
 // Includes under test
 #include <libgtfoklahoma/rules.hpp>
+#include <libgtfoklahoma/stat_batch.hpp>
 
 #include <iostream>
 using namespace libgtfoklahoma;
@@ -50,3 +51,60 @@ TEST_CASE("Rules", "[unit]") {
     REQUIRE(actual_result == 9);
   }
 }
+
+TEST_CASE("Rules - Batches", "[unit]") {
+  // Riders with a spread of stats, each with their own dice
+  StatBatch batch;
+  RngBatch rngs;
+  std::vector<StatModel> riders;
+  std::vector<Rng> dice;
+  for (int32_t i = 0; i < 1000; i++) {
+    StatModel stats(0, 100, i % 150, 1 + i % 20, 0, (i % 10) / 10.0, (i % 7) / 7.0);
+    batch.push_back(stats);
+    riders.push_back(stats);
+    dice.emplace_back(i);
+    rngs.add(dice.back());
+  }
+
+  SECTION("StatBatch::get") {
+    REQUIRE(batch.size() == riders.size());
+    REQUIRE(batch.get(123) == riders[123]);
+    riders[5].health = 1;
+    batch.set(5, riders[5]);
+    REQUIRE(batch.get(5) == riders[5]);
+  }
+
+  SECTION("rules::RealSpeeds") {
+    std::vector<int32_t> speeds;
+    RealSpeeds(batch, speeds);
+    bool matches = speeds.size() == riders.size();
+    for (size_t i = 0; matches && i < riders.size(); i++) {
+      matches = speeds[i] == RealSpeed(riders[i]);
+    }
+    REQUIRE(matches);
+  }
+
+  SECTION("rules::*IssuesThisHour") {
+    std::vector<uint8_t> health;
+    std::vector<uint8_t> mechanical;
+    bool matches = true;
+    for (int hour = 0; hour < 3; hour++) {
+      HealthIssuesThisHour(batch, rngs, health);
+      MechanicalIssuesThisHour(batch, rngs, mechanical);
+      for (size_t i = 0; matches && i < riders.size(); i++) {
+        matches = health[i] == HealthIssueThisHour(riders[i], dice[i]) &&
+                  mechanical[i] == MechanicalIssueThisHour(riders[i], dice[i]);
+      }
+    }
+    REQUIRE(matches);
+    REQUIRE(rngs.getState(999) == dice[999].getState());
+  }
+
+  SECTION("rules::*IssuesThisHour - mismatched rngs") {
+    RngBatch tooFew;
+    tooFew.add(Rng(1));
+    std::vector<uint8_t> health;
+    HealthIssuesThisHour(batch, tooFew, health);
+    REQUIRE(health == std::vector<uint8_t>(riders.size(), 0));
+  }
+}
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "helpers.hpp"
+
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/save_store.hpp>
+
+using namespace libgtfoklahoma;
+using namespace testhelpers;
+
+namespace {
+const char *kItemJson = R"(
+  [
+    {"id": 0, "category": "MISC", "cost": 1, "display_name": "", "image_url": "", "stat_changes": [{}]},
+    {"id": 1, "category": "MISC", "cost": 1, "display_name": "", "image_url": "", "stat_changes": [{}]}
+  ]
+  )";
+
+std::unique_ptr<Game> makeGame(uint64_t seed) {
+  return std::make_unique<Game>("", validActionJson, validEndingJson, validEventJson, validIssueJson, kItemJson, seed);
+}
+
+void requireSameState(Game &lhs, Game &rhs) {
+  REQUIRE(lhs.getCurrentHour() == rhs.getCurrentHour());
+  REQUIRE(lhs.getCurrentMile() == rhs.getCurrentMile());
+  REQUIRE(lhs.getStats().getPlayerStatsModel() == rhs.getStats().getPlayerStatsModel());
+  REQUIRE(lhs.getInventoryCounts() == rhs.getInventoryCounts());
+  REQUIRE(lhs.getEndingHintIds() == rhs.getEndingHintIds());
+  REQUIRE(lhs.getActions().getActionsThatHaveAlreadyHappened() ==
+          rhs.getActions().getActionsThatHaveAlreadyHappened());
+  REQUIRE(lhs.getIssues().getIssuesThatHaveAlreadyHappened() ==
+          rhs.getIssues().getIssuesThatHaveAlreadyHappened());
+  REQUIRE(lhs.getActionRng().getState() == rhs.getActionRng().getState());
+  REQUIRE(lhs.getIssueRng().getState() == rhs.getIssueRng().getState());
+}
+
+class Observer : public TestObserver {
+public:
+  explicit Observer(Game &game) : TestObserver(game) {}
+  bool onIssueOccurred(const IssueModel &issue) override {
+    m_game.getIssues().chooseAction(issue.id, 0);
+    return true;
+  }
+};
+}
+
+TEST_CASE("SaveStore") {
+  SaveStore store(":memory:");
+
+  auto game = makeGame(1234);
+  game->setCurrentHour(13);
+  game->setCurrentMile(42);
+  game->pushEndingHintId(0);
+  game->updateStats(StatModel(0, -10));
+  game->addItemToInventory(0, 3);
+  game->getIssues().handleIssue(0, std::make_shared<Observer>(*game));
+  game->getIssueRng().next();
+
+  SECTION("Save and load") {
+    REQUIRE(store.save(1, *game));
+    REQUIRE(store.contains(1));
+    REQUIRE(store.getSeed(1) == 1234);
+
+    auto loaded = makeGame(*store.getSeed(1));
+    REQUIRE(store.load(1, *loaded));
+    requireSameState(*game, *loaded);
+  }
+
+  SECTION("Checkpoints only carry what changed") {
+    store.save(1, *game);
+    REQUIRE(game->getUnsavedChanges().inventory_ids.empty());
+
+    game->removeItemFromInventory(0, 3);
+    game->addItemToInventory(1);
+    game->setCurrentMile(43);
+    REQUIRE(game->getUnsavedChanges().inventory_ids == std::set<int32_t>{0, 1});
+
+    store.checkpoint(1, *game);
+    REQUIRE(game->getUnsavedChanges().inventory_ids.empty());
+
+    auto loaded = makeGame(1234);
+    REQUIRE(store.load(1, *loaded));
+    requireSameState(*game, *loaded);
+  }
+
+  SECTION("Batched checkpoints") {
+    auto other = makeGame(5678);
+    other->setCurrentMile(7);
+    store.checkpoint({{1, *game}, {2, *other}});
+
+    auto loaded = makeGame(5678);
+    REQUIRE(store.load(2, *loaded));
+    requireSameState(*other, *loaded);
+  }
+
+  SECTION("Games waiting on the player aren't saved") {
+    class UndecidedObserver : public TestObserver {
+    public:
+      explicit UndecidedObserver(Game &game) : TestObserver(game) {}
+      bool onEvent(const EventModel &) override { return true; }
+    };
+    game->getEvents().handleEvent(0, std::make_shared<UndecidedObserver>(*game));
+    REQUIRE(game->awaitingInput());
+
+    REQUIRE_FALSE(store.save(1, *game));
+    REQUIRE_FALSE(store.checkpoint(1, *game));
+    REQUIRE_FALSE(store.contains(1));
+
+    // The rest of a batch is still written
+    auto other = makeGame(5678);
+    REQUIRE_FALSE(store.checkpoint({{1, *game}, {2, *other}}));
+    REQUIRE_FALSE(store.contains(1));
+    REQUIRE(store.contains(2));
+    REQUIRE_FALSE(game->getUnsavedChanges().inventory_ids.empty());
+  }
+
+  SECTION("Wrong seed or missing saves aren't loaded") {
+    store.save(1, *game);
+    REQUIRE_FALSE(store.load(1, *makeGame(1)));
+    REQUIRE_FALSE(store.load(2, *makeGame(1234)));
+    REQUIRE_FALSE(store.getSeed(2));
+
+    store.remove(1);
+    REQUIRE_FALSE(store.contains(1));
+  }
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include <libgtfoklahoma/seqlock.hpp>
+#include <libgtfoklahoma/stat_model.hpp>
+
+using namespace libgtfoklahoma;
+
+TEST_CASE("SeqLock", "[unit]") {
+
+  SECTION("SeqLock::load") {
+    SeqLock<StatModel> lock(StatModel(1, 2, 3, 4, 5, .6, .7, StatModel::Pace::FRED, 8));
+    REQUIRE(lock.load() == StatModel(1, 2, 3, 4, 5, .6, .7, StatModel::Pace::FRED, 8));
+
+    lock.store(StatModel(9));
+    REQUIRE(lock.load() == StatModel(9));
+  }
+
+  SECTION("SeqLock::load - never torn") {
+    // Every field is written with the same value so a torn read shows up as a mismatch
+    const auto uniform = [](int32_t i) {
+      return StatModel(i, i, i, i, i, i, i, StatModel::Pace::INVALID, i);
+    };
+
+    SeqLock<StatModel> lock(uniform(0));
+    std::atomic<bool> writing(true);
+    std::thread writer([&lock, &writing, &uniform]() {
+      for (int32_t i = 1; i <= 100000; ++i) {
+        lock.store(uniform(i));
+      }
+      writing = false;
+    });
+
+    bool torn = false;
+    int32_t last = 0;
+    bool wentBackwards = false;
+    while (writing) {
+      const auto stats = lock.load();
+      torn |= !(stats == uniform(stats.health));
+      wentBackwards |= stats.health < last;
+      last = stats.health;
+    }
+    writer.join();
+
+    REQUIRE_FALSE(torn);
+    REQUIRE_FALSE(wentBackwards);
+    REQUIRE(lock.load() == uniform(100000));
+  }
+}
@@ -0,0 +1,222 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "helpers.hpp"
+
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/simulator.hpp>
+
+using namespace libgtfoklahoma;
+using namespace testhelpers;
+
+namespace {
+const char *kActionJson = R"(
+  [
+    {
+      "id": 0,
+      "display_name": "Eat a burrito",
+      "type": ["STAT_CHANGE"],
+      "stat_changes_regardless": [{"health": 10}]
+    },
+    {
+      "id": 1,
+      "display_name": "Eat gas station sushi",
+      "type": ["STAT_CHANGE"],
+      "stat_changes_regardless": [{"health": -5}]
+    },
+    {
+      "id": 2,
+      "display_name": "Go shopping",
+      "type": ["STORE"],
+      "items": [0]
+    }
+  ]
+  )";
+
+const char *kEventJson = R"(
+  [
+    {
+      "id": 0,
+      "actions": [0, 1],
+      "description": "",
+      "display_name": "",
+      "mile": 0
+    },
+    {
+      "id": 1,
+      "actions": [2],
+      "description": "",
+      "display_name": "",
+      "mile": 2
+    },
+    {
+      "id": 2,
+      "actions": [0, 1],
+      "description": "",
+      "display_name": "",
+      "mile": 4
+    }
+  ]
+  )";
+
+const char *kIssueJson = R"(
+  [
+    {
+      "id": 0,
+      "actions": [0, 1],
+      "description": "",
+      "display_name": "Hangry",
+      "image_url": "",
+      "type": "HEALTH"
+    }
+  ]
+  )";
+
+const char *kItemJson = R"(
+  [
+    {
+        "id": 0,
+        "category": "MISC",
+        "cost": 20,
+        "display_name": "Bottle of Tums",
+        "image_url": "",
+        "stat_changes": [{"money_remaining": -20}]
+    }
+  ]
+  )";
+
+std::unique_ptr<Game> makeGame(uint64_t seed=0) {
+  return std::make_unique<Game>("", kActionJson, validEndingJson, kEventJson, kIssueJson, kItemJson, seed);
+}
+}
+
+TEST_CASE("Simulator - Histogram", "[unit]") {
+  sim::Histogram histogram;
+  REQUIRE(histogram.mean() == 0);
+  REQUIRE(histogram.percentile(0.5) == 0);
+
+  for (int64_t value : {1, 2, 2, 3, 10}) {
+    histogram.add(value);
+  }
+  REQUIRE(histogram.total == 5);
+  REQUIRE(histogram.mean() == Approx(3.6));
+  REQUIRE(histogram.percentile(0) == 1);
+  REQUIRE(histogram.percentile(0.5) == 2);
+  REQUIRE(histogram.percentile(1) == 10);
+
+  sim::Histogram other;
+  other.add(2);
+  histogram.merge(other);
+  REQUIRE(histogram.total == 6);
+  REQUIRE(histogram.counts[2] == 3);
+}
+
+TEST_CASE("Simulator - Single playthrough") {
+  SECTION("Greedy policy picks the best action") {
+    auto game = makeGame();
+    sim::GreedyPolicy policy;
+    auto result = sim::Simulate(*game, policy, 1000000);
+
+    REQUIRE(result.completed);
+    REQUIRE(result.survived);
+    REQUIRE(result.mile_reached == 4);
+    REQUIRE(result.money_spent == 0);
+    REQUIRE(game->getActions().actionHasHappened(0));
+    REQUIRE_FALSE(game->getActions().actionHasHappened(1));
+  }
+
+  SECTION("Greedy policy ignores outcomes that can't happen") {
+    // The first action's success delta never applies since it can't fail
+    const char *actionJson = R"(
+    [
+      {
+        "id": 0,
+        "display_name": "Promise yourself a nap",
+        "type": ["STAT_CHANGE"],
+        "stat_changes_on_success": [{"health": 100}]
+      },
+      {
+        "id": 1,
+        "display_name": "Eat a burrito",
+        "type": ["STAT_CHANGE"],
+        "stat_changes_regardless": [{"health": 10}]
+      }
+    ]
+    )";
+    const char *eventJson = R"(
+    [
+      {"id": 0, "actions": [0, 1], "description": "", "display_name": "", "mile": 0}
+    ]
+    )";
+    Game game("", actionJson, validEndingJson, eventJson, kIssueJson, kItemJson);
+    sim::GreedyPolicy policy;
+    sim::Simulate(game, policy, 1000000);
+
+    REQUIRE(game.getActions().actionHasHappened(1));
+    REQUIRE_FALSE(game.getActions().actionHasHappened(0));
+  }
+
+  SECTION("Scripted policy follows the script") {
+    auto game = makeGame();
+    sim::ScriptedPolicy policy({{0, 1}, {2, 1}}, {{0, 1}}, {0});
+    auto result = sim::Simulate(*game, policy, 1000000);
+
+    REQUIRE(result.completed);
+    REQUIRE(result.money_spent == 20);
+    REQUIRE(game->inventoryCount(0) == 1);
+    REQUIRE_FALSE(game->getActions().actionHasHappened(0));
+    REQUIRE(game->getActions().actionHasHappened(1));
+  }
+
+  SECTION("Gives up at the tick limit") {
+    auto game = makeGame();
+    sim::GreedyPolicy policy;
+    auto result = sim::Simulate(*game, policy, 1);
+
+    REQUIRE_FALSE(result.completed);
+    REQUIRE_FALSE(result.survived);
+    REQUIRE(result.mile_reached < 4);
+  }
+}
+
+TEST_CASE("Simulator - Batch") {
+  sim::Options options;
+  options.playthroughs = 100;
+  options.threads = 4;
+  options.seed = 42;
+  options.make_game = makeGame;
+
+  auto report = sim::Run(options);
+  REQUIRE(report.playthroughs == 100);
+  REQUIRE(report.completed == 100);
+  REQUIRE(report.miles_reached.total == 100);
+  REQUIRE(report.miles_reached.counts[4] == report.survived);
+
+  // The same batch seed plays out the same way, however many threads there are
+  options.threads = 1;
+  auto again = sim::Run(options);
+  REQUIRE(again.survived == report.survived);
+  REQUIRE(again.issues_hit.counts == report.issues_hit.counts);
+  REQUIRE(again.miles_reached.counts == report.miles_reached.counts);
+
+  // Seeds only depend on the batch seed and the playthrough's index
+  REQUIRE(sim::PlaythroughSeed(42, 7) == sim::PlaythroughSeed(42, 7));
+  REQUIRE(sim::PlaythroughSeed(42, 7) != sim::PlaythroughSeed(42, 8));
+  REQUIRE(sim::PlaythroughSeed(42, 7) != sim::PlaythroughSeed(43, 7));
+}
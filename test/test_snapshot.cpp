@@ -0,0 +1,125 @@
+/*
+ * This file is part of the libgtfoklahoma distribution (https://github.com/arenson/libgtfoklahoma)
+ * Copyright (c) 2020 Josh Arenson.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "helpers.hpp"
+
+#include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/snapshot.hpp>
+
+using namespace libgtfoklahoma;
+using namespace testhelpers;
+
+namespace {
+const char *kActionJson = R"(
+  [
+    {"id": 3, "display_name": "", "type": ["STAT_CHANGE"]},
+    {"id": 70, "display_name": "", "type": ["STAT_CHANGE"]},
+    {"id": 200, "display_name": "", "type": ["STAT_CHANGE"]}
+  ]
+  )";
+
+const char *kItemJson = R"(
+  [
+    {"id": 0, "category": "MISC", "cost": 1, "display_name": "", "image_url": "", "stat_changes": [{}]},
+    {"id": 9, "category": "MISC", "cost": 1, "display_name": "", "image_url": "", "stat_changes": [{}]}
+  ]
+  )";
+
+std::unique_ptr<Game> makeGame(uint64_t seed) {
+  return std::make_unique<Game>("", kActionJson, validEndingJson, validEventJson, validIssueJson, kItemJson, seed);
+}
+}
+
+TEST_CASE("Snapshot") {
+  auto game = makeGame(99);
+  game->setCurrentHour(20);
+  game->setCurrentMile(300);
+  game->pushEndingHintId(0);
+  game->pushEndingHintId(4);
+  game->updateStats(StatModel(1, -20, 5));
+  game->addItemToInventory(9, 2);
+  game->addItemToInventory(0);
+  game->getActions().setActionsThatHaveAlreadyHappened({3, 70, 200});
+  game->getIssues().setIssuesThatHaveAlreadyHappened({0});
+  game->getActionRng().next();
+
+  auto bytes = snapshot::Write(*game);
+  REQUIRE(snapshot::ReadSeed(bytes.data(), bytes.size()) == 99);
+
+  SECTION("Round trip") {
+    auto copy = makeGame(99);
+    REQUIRE(snapshot::Read(bytes.data(), bytes.size(), *copy));
+
+    REQUIRE(copy->getCurrentHour() == 20);
+    REQUIRE(copy->getCurrentMile() == 300);
+    REQUIRE(copy->getStats().getPlayerStatsModel() == game->getStats().getPlayerStatsModel());
+    REQUIRE(copy->getInventoryCounts() == game->getInventoryCounts());
+    REQUIRE(copy->getEndingHintIds() == std::vector<int32_t>{0, 4});
+    REQUIRE(copy->getActions().getActionsThatHaveAlreadyHappened() ==
+            std::unordered_set<int32_t>{3, 70, 200});
+    REQUIRE(copy->getIssues().getIssuesThatHaveAlreadyHappened() == std::unordered_set<int32_t>{0});
+    REQUIRE(copy->getActionRng().getState() == game->getActionRng().getState());
+    REQUIRE(copy->getIssueRng().getState() == game->getIssueRng().getState());
+  }
+
+  SECTION("Appends to an existing buffer") {
+    std::vector<uint8_t> buffer{1, 2, 3};
+    snapshot::Write(*game, buffer);
+    REQUIRE(buffer.size() == bytes.size() + 3);
+
+    auto copy = makeGame(99);
+    REQUIRE(snapshot::Read(buffer.data() + 3, buffer.size() - 3, *copy));
+  }
+
+  SECTION("Rejects what it can't read") {
+    REQUIRE_FALSE(snapshot::Read(bytes.data(), bytes.size() - 1, *makeGame(99)));
+    REQUIRE_FALSE(snapshot::Read(bytes.data(), bytes.size(), *makeGame(100)));
+
+    auto badVersion = bytes;
+    badVersion[4]++;
+    REQUIRE_FALSE(snapshot::Read(badVersion.data(), badVersion.size(), *makeGame(99)));
+    REQUIRE_FALSE(snapshot::ReadSeed(badVersion.data(), badVersion.size()));
+  }
+}
+
+TEST_CASE("Snapshot - Widely spread ids") {
+  const char *actionJson = R"(
+  [
+    {"id": 0, "display_name": "", "type": ["STAT_CHANGE"]},
+    {"id": 2000000000, "display_name": "", "type": ["STAT_CHANGE"]}
+  ]
+  )";
+  auto makeSparseGame = [actionJson]() {
+    return std::make_unique<Game>("", actionJson, validEndingJson, validEventJson, validIssueJson, kItemJson, 99);
+  };
+
+  auto game = makeSparseGame();
+  game->getActions().setActionsThatHaveAlreadyHappened({0, 2000000000});
+  game->getIssues().setIssuesThatHaveAlreadyHappened({0});
+
+  // Listed out rather than as a bitset covering the whole range
+  auto bytes = snapshot::Write(*game);
+  REQUIRE(bytes.size() < 1024);
+
+  auto copy = makeSparseGame();
+  REQUIRE(snapshot::Read(bytes.data(), bytes.size(), *copy));
+  REQUIRE(copy->getActions().getActionsThatHaveAlreadyHappened() ==
+          std::unordered_set<int32_t>{0, 2000000000});
+  REQUIRE(copy->getIssues().getIssuesThatHaveAlreadyHappened() == std::unordered_set<int32_t>{0});
+}
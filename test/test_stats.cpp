@@ -18,6 +18,7 @@
 #include <catch2/catch.hpp>
 
 #include <libgtfoklahoma/game.hpp>
+#include <libgtfoklahoma/stat_batch.hpp>
 #include <libgtfoklahoma/stats.hpp>
 
 using namespace libgtfoklahoma;
@@ -51,6 +52,60 @@ TEST_CASE("Stats", "[unit]") {
     REQUIRE(result.odds_mech_issue == .5);
     REQUIRE(result.pace == StatModel::Pace::MERCKX);
     REQUIRE(result.wakeup_hour == 5);
+
+    // Neither side is touched
+    REQUIRE(lhs.max_mph == 0);
+    REQUIRE(lhs.pace == StatModel::Pace::CHILL_AF);
+    REQUIRE(rhs.max_mph == 5);
+  }
+
+  SECTION("StatModel::operator*") {
+    const StatModel delta(1, -10, 2, 1, -5, .25, -.5, StatModel::Pace::MERCKX, 0);
+
+    auto repeated = StatModel(0, 0, 0, 0);
+    for (int i = 0; i < 4; ++i) { repeated += delta; }
+    REQUIRE(delta * 4 == repeated);
+    REQUIRE(delta * 1 == delta);
+
+    // Nothing at all, not even the pace
+    REQUIRE(delta * 0 == StatModel(0, 0, 0, 0));
+  }
+
+  SECTION("StatModel::operator+=") {
+    StatModel stats(20, 100, 10, 15, 50, .1, .2, StatModel::Pace::FRED, 6);
+    const StatModel delta(1, -10, 0, 2, -5, .05, -.1);
+
+    const auto expected = stats + delta;
+    stats += delta;
+    REQUIRE(stats == expected);
+    REQUIRE(stats == StatModel(21, 90, 10, 17, 45, .1 + .05, .2 - .1, StatModel::Pace::FRED, 6));
+  }
+
+  SECTION("StatBatch::add") {
+    std::vector<StatModel> riders;
+    StatBatch batch;
+    std::vector<uint8_t> flags;
+    for (int32_t i = 0; i < 37; ++i) {
+      riders.emplace_back(20, 100 - i, i, 10 + i % 7, 50, .01 * i, .02, StatModel::Pace::CHILL_AF, 6);
+      batch.push_back(riders.back());
+      flags.push_back(i % 3 == 0);
+    }
+
+    const StatModel delta(0, -15, 2, -1, -20, .05, .1, StatModel::Pace::MERCKX);
+    auto everyone = batch;
+    everyone.add(delta);
+    batch.add(delta, flags);
+    for (size_t i = 0; i < riders.size(); ++i) {
+      REQUIRE(everyone.get(i) == riders[i] + delta);
+      REQUIRE(batch.get(i) == (flags[i] ? riders[i] + delta : riders[i]));
+    }
+
+    // A mismatched mask leaves the batch alone
+    const auto before = batch;
+    batch.add(delta, std::vector<uint8_t>(3, 1));
+    for (size_t i = 0; i < riders.size(); ++i) {
+      REQUIRE(batch.get(i) == before.get(i));
+    }
   }
 
   SECTION("Stats::FromJson") {